@@ -67,16 +67,8 @@ void LFDFA::getSets(std::set<std::string> &Sp, std::set<std::string> &Sm, unsign
         Sm.insert(string);
     }
 
-    auto &delta = getTransitions();
-
-    auto transitionsFromState = delta.find(state);
-
-    // state does not have any outgoing transition
-    if (transitionsFromState == delta.cend()) {
-        return;
-    }
-
-    for (auto transition : transitionsFromState->second) {
+    // The row is empty if state does not have any outgoing transition
+    for (const auto &transition : getTransitions(state)) {
         string += transition.first;
         getSets(Sp, Sm, transition.second, string);
         string.pop_back();
@@ -1,6 +1,8 @@
 #include <iostream>
 #include <istream>
 #include <array>
+#include <sstream>
+#include <chrono>
 
 #include <sys/resource.h>
 
@@ -10,6 +12,9 @@
 #include "gsjj/passive/Method.h"
 #include "gsjj/passive/utils.h"
 #include "gsjj/passive/MethodFactory.h"
+#include "gsjj/passive/Sample.h"
+#include "gsjj/passive/SearchStrategy.h"
+#include "gsjj/passive/CNF/SATCNFMethod.h"
 
 #include "LFDFA.h"
 
@@ -34,17 +39,13 @@ void print_Sp_Sm(const std::set<std::string> &Sp, const std::set<std::string> &S
 
 /**
  * Constructs a method and solves it for a fixed n
- * @param Sp The Sp set
- * @param Sm The Sm set
- * @param S The S set
- * @param prefixes The prefixes set
- * @param alphabet The alphabet set
+ * @param sample The sample
  * @param n The number of states
  * @param choice The choice of method to construct
  * @return The method already solved
  */
-std::unique_ptr<passive::Method> call_method_fixed_n(const std::set<std::string> &Sp, const std::set<std::string> &Sm, const std::set<std::string> &S, const std::set<std::string> &prefixes, const std::set<char> &alphabet, unsigned int n, const std::string &choice) {
-    std::unique_ptr<passive::Method> method = passive::constructMethod(choice, n, Sp, Sm, S, prefixes, alphabet);
+std::unique_ptr<passive::Method> call_method_fixed_n(const std::shared_ptr<const passive::Sample> &sample, unsigned int n, const std::string &choice) {
+    std::unique_ptr<passive::Method> method = passive::constructMethod(choice, n, sample);
 
     method->solve();
     std::cout << "TIME TAKEN: " << method->timeToSolve() << "\n";
@@ -60,26 +61,54 @@ std::unique_ptr<passive::Method> call_method_fixed_n(const std::set<std::string>
     return std::move(method);
 }
 
+/**
+ * Seeks the optimal DFA with a single method or, if the portfolio is not empty, with several methods at the same time.
+ * @param method The method to execute (ignored if the portfolio is not empty)
+ * @param portfolio The methods to run at the same time (see passive::constructMethodPortfolio)
+ * @param sample The sample, shared by every constructed method
+ * @param timeLimit The time limit (in seconds)
+ * @param timeTaken Receives the time used by the solvers. With a portfolio, it's the elapsed time since the solvers run at the same time
+ * @param incremental Whether the number of states is searched in incremental mode
+ * @param strategy The strategy used to seek the minimal number of states (ignored if the portfolio is not empty)
+ * @param numberThreads The number of numbers of states solved at the same time (ignored if the portfolio is not empty)
+ * @return The method and true iff the optimal DFA was found (see passive::constructMethod)
+ */
+std::pair<std::unique_ptr<passive::Method>, bool> findOptimal(const std::string &method, const std::vector<std::string> &portfolio, const std::shared_ptr<const passive::Sample> &sample, unsigned int timeLimit, long double &timeTaken, bool incremental, passive::SearchStrategy &strategy, unsigned int numberThreads) {
+    if (portfolio.empty()) {
+        return passive::constructMethod(method, sample, strategy, std::chrono::seconds(timeLimit), &timeTaken, incremental, numberThreads);
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    std::string winner;
+    auto result = passive::constructMethodPortfolio(portfolio, sample, std::chrono::seconds(timeLimit), &winner, incremental);
+    timeTaken = std::chrono::duration<long double>(std::chrono::steady_clock::now() - start).count();
+    if (result.first) {
+        std::cerr << "Winner: " << winner << "\n";
+    }
+    return result;
+}
+
 /**
  * Execute a method on the sample described in the input file.
  * 
  * It prints the timeTaken to find the optimal DFA (or something around the timeLimit if it did not have enough time).
  * @param method The method to execute
+ * @param portfolio If not empty, the methods to run at the same time instead of method
  * @param input The input file
  * @param timeLimit The time limit (in seconds)
+ * @param incremental Whether the number of states is searched in incremental mode
+ * @param strategy The strategy used to seek the minimal number of states
+ * @param numberThreads The number of numbers of states solved at the same time
  * @return True iff the method could find the optimal DFA
  */
-bool benchmarks(const std::string &method, const std::string &input, unsigned int timeLimit) {
-    std::set<std::string> Sp, Sm, S, prefixes;
-    std::set<char> alphabet;
+bool benchmarks(const std::string &method, const std::vector<std::string> &portfolio, const std::string &input, unsigned int timeLimit, bool incremental, passive::SearchStrategy &strategy, unsigned int numberThreads) {
+    std::set<std::string> Sp, Sm;
     passive::readFromFile(input, Sp, Sm);
-    S = passive::computeS(Sp, Sm);
-    prefixes = passive::computePrefixes(S);
-    alphabet = passive::computeAlphabet(S);
+    auto sample = std::make_shared<const passive::Sample>(std::move(Sp), std::move(Sm));
     long double timeTaken = 0;
     std::unique_ptr<passive::Method> ptr;
     bool success;
-    std::tie(ptr, success) = passive::constructMethod(method, Sp, Sm, S, prefixes, alphabet, std::chrono::seconds(timeLimit), &timeTaken);
+    std::tie(ptr, success) = findOptimal(method, portfolio, sample, timeLimit, timeTaken, incremental, strategy, numberThreads);
     std::cout << timeTaken << "\n";
     return success;
 }
@@ -89,31 +118,33 @@ bool benchmarks(const std::string &method, const std::string &input, unsigned in
  * 
  * It prints the timeTaken to find the optimal DFA (or something around the timeLimit if it did not have enough time).
  * @param method The method to execute
+ * @param portfolio If not empty, the methods to run at the same time instead of method
  * @param input The input file
  * @param timeLimit The time limit (in seconds)
+ * @param incremental Whether the number of states is searched in incremental mode
+ * @param strategy The strategy used to seek the minimal number of states
+ * @param numberThreads The number of numbers of states solved at the same time
  * @return True iff the method could find the optimal DFA
  */
-bool benchmarksLoopFree(const std::string &method, const std::string &input, unsigned int timeLimit) {
+bool benchmarksLoopFree(const std::string &method, const std::vector<std::string> &portfolio, const std::string &input, unsigned int timeLimit, bool incremental, passive::SearchStrategy &strategy, unsigned int numberThreads) {
     auto dfa = LFDFA::loadFromFile(input);
     std::set<std::string> Sp, Sm;
     dfa->getSets(Sp, Sm);
-    auto S = passive::computeS(Sp, Sm);
-    auto alphabet = passive::computeAlphabet(S);
-    auto prefixes = passive::computePrefixes(S);
+    auto sample = std::make_shared<const passive::Sample>(std::move(Sp), std::move(Sm));
 
     long double timeTaken = 0;
     std::unique_ptr<passive::Method> ptr;
     bool success;
-    std::tie(ptr, success) = passive::constructMethod(method, Sp, Sm, S, prefixes, alphabet, std::chrono::seconds(timeLimit), &timeTaken);
+    std::tie(ptr, success) = findOptimal(method, portfolio, sample, timeLimit, timeTaken, incremental, strategy, numberThreads);
     std::cout << timeTaken << "\n";
     return success;
 }
 
 int main(int argc, char** argv) {
-    std::string choice;
+    std::string choice, search, portfolioList, atMostOne;
     std::string inputFile, outputFile;
-    bool toDot, verbose, generateSample, bench, loopFree;
-    unsigned int n, numberWords, wordSize, minWordSize, maxWordSize, alphabetSize, timeLimit;
+    bool toDot, verbose, generateSample, bench, loopFree, incremental;
+    unsigned int n, numberWords, wordSize, minWordSize, maxWordSize, alphabetSize, timeLimit, upperBound, numberThreads;
     double probabilityAccepted;
 
     po::options_description desc("Benchmarks for learning DFA algorithms. For the moment, it only works for passive algorithms.");
@@ -150,6 +181,14 @@ int main(int argc, char** argv) {
         ("alphabet-size", po::value<unsigned int>(&alphabetSize)->default_value(10), "Use this option to change the size of the alphabet used to randomly generated the samples. By default, 10")
         ("probability-accepted", po::value<double>(&probabilityAccepted)->default_value(0.5)->notifier([](double i) { if (!(0 <= i && i <= 1)) {throw std::runtime_error("--probability-accepted must be in [0, 1]");}}), "Use this option to change the probability that a generated word is added to the set of words that the DFA must accept. The probability that a word must be rejected is 1 minus this probability. By default, 0.5")
 
+        ("incremental", po::bool_switch(&incremental), "If set (and if n is not set), the methods that support it keep their solver alive while the number of states grows instead of starting from scratch for each n")
+
+        ("search", po::value<std::string>(&search)->default_value("linear"), "The strategy used to seek the minimal number of states (if n is not set). Possible values: linear (n = 1, 2, 3, ...), exponential (n = 1, 2, 4, 8, ... and then a binary search), descending (from upper-bound down to the first n without DFA) and satFirst (like descending but jumps right below the number of states really used by the best DFA found). By default, linear")
+        ("portfolio", po::value<std::string>(&portfolioList), "A comma-separated list of methods (for example, heule,unary,biermann) to run at the same time instead of the method (if n is not set). The methods share the numbers of states proven impossible and the first method to find the optimal DFA stops the others. The search strategy is ignored")
+        ("threads", po::value<unsigned int>(&numberThreads)->default_value(1)->notifier([](unsigned int i) { if (i == 0) {throw std::runtime_error("--threads must be at least 1");}}), "The number of numbers of states solved at the same time (if n is not set). If greater than 1, the numbers of states are tried in increasing order: a DFA with n states cancels the larger numbers and a proof that there is none cancels the smaller ones. The search strategy then only records the bounds. By default, 1")
+        ("at-most-one", po::value<std::string>(&atMostOne)->default_value("pairwise"), "The encoding of the 'at most one' constraints of the unary, heule and heuleBFS methods. Possible values: pairwise, sequential (sequential counter), commander and product. By default, pairwise")
+        ("upper-bound", po::value<unsigned int>(&upperBound)->default_value(0), "The first number of states tried by the descending and satFirst search strategies. If 0, the number of prefixes in the sample is used. By default, 0")
+
         ("time-limit", po::value<unsigned int>(&timeLimit)->default_value(300), "The time limit, in seconds, the program has to find the best possible solution. If 0, there is no time limit. It's possible the program takes more time than the time limit allows because the program needs the reach a point where it checks if it must stops and some computation's steps take time. By default, 300s.")
     ;
 
@@ -207,6 +246,32 @@ int main(int argc, char** argv) {
         }
     }
 
+    std::vector<std::string> portfolio;
+    std::istringstream portfolioStream(portfolioList);
+    std::string portfolioMethod;
+    while (std::getline(portfolioStream, portfolioMethod, ',')) {
+        if (!portfolioMethod.empty()) {
+            portfolio.push_back(portfolioMethod);
+        }
+    }
+
+    std::unique_ptr<passive::SearchStrategy> strategy;
+    try {
+        strategy = passive::constructSearchStrategy(search, upperBound);
+    }
+    catch (std::invalid_argument &e) {
+        std::cerr << e.what() << "\n";
+        return 9;
+    }
+
+    try {
+        passive::CNF::SATCNFMethod::setDefaultAtMostOneEncoding(passive::CNF::atMostOneEncodingFromName(atMostOne));
+    }
+    catch (std::invalid_argument &e) {
+        std::cerr << e.what() << "\n";
+        return 10;
+    }
+
     if (generateSample) {
         std::set<std::string> Sp, Sm;
         if (variables.count("min-word-size")) {
@@ -222,20 +287,20 @@ int main(int argc, char** argv) {
     }
     else if (bench) {
         if (loopFree) {
-            if (benchmarksLoopFree(choice, inputFile, timeLimit)) {
+            if (benchmarksLoopFree(choice, portfolio, inputFile, timeLimit, incremental, *strategy, numberThreads)) {
                 return 0;
             }
 			return 1;
         }
         else {
-            if (benchmarks(choice, inputFile, timeLimit)) {
+            if (benchmarks(choice, portfolio, inputFile, timeLimit, incremental, *strategy, numberThreads)) {
                 return 0;
             }
             return 1;
         }
     }
     else {
-        if (!variables.count("method")) {
+        if (!variables.count("method") && portfolio.empty()) {
             std::cerr << "The method must be provided if a benchmarks suite is not enable. Please see the help: \n";
             std::cerr << desc << "\n";
             return 3;
@@ -260,20 +325,16 @@ int main(int argc, char** argv) {
             print_Sp_Sm(Sp, Sm, std::cout);
         }
 
-        std::set<std::string> S;
-        S = passive::computeS(Sp, Sm);
-        
-        std::set<std::string> prefixes = passive::computePrefixes(S);
-        std::set<char> alphabet = passive::computeAlphabet(S);
+        auto sample = std::make_shared<const passive::Sample>(std::move(Sp), std::move(Sm));
 
         std::unique_ptr<passive::Method> method;
         if (variables.count("number-states")) {
-            method = call_method_fixed_n(Sp, Sm, S, prefixes, alphabet, n, choice);
+            method = call_method_fixed_n(sample, n, choice);
         }
         else {
             long double timeTaken = 0;
             bool succes;
-            std::tie(method, succes) = passive::constructMethod(choice, Sp, Sm, S, prefixes, alphabet, std::chrono::seconds(timeLimit), &timeTaken);
+            std::tie(method, succes) = findOptimal(choice, portfolio, sample, timeLimit, timeTaken, incremental, *strategy, numberThreads);
             if (succes) {
                 std::cout << "We found the best possible DFA\n";
             }
@@ -0,0 +1,84 @@
+/**
+ * \file matcherBenchmarks.cpp
+ *
+ * Compares the interpreted DFA::isAccepted with CompiledDFA and with the matchers generated by matcherGenerator (see gsjj::generateMatcher), and checks that they classify every word in the same way.
+ *
+ * Usage: matcherBenchmarks [number-words]
+ *
+ * The words are drawn from the sample of the loop-free DFA the matchers were generated from (MATCHER_KIS_FILE).
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <random>
+#include <set>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "gsjj/CompiledDFA.h"
+
+#include "LFDFA.h"
+
+#include "switchMatcher.h"
+#include "tableMatcher.h"
+
+using namespace gsjj;
+
+/**
+ * Classifies every word and prints the time taken and the number of accepted words
+ * @param name The name of the classifier
+ * @param words The words
+ * @param isAccepted The classifier
+ * @return Whether each word is accepted
+ */
+template<typename Classifier>
+std::vector<bool> measure(const std::string &name, const std::vector<std::vector<char>> &words, Classifier isAccepted) {
+    std::vector<bool> results(words.size());
+    auto start = std::chrono::steady_clock::now();
+    for (std::size_t i = 0 ; i < words.size() ; i++) {
+        results[i] = isAccepted(words[i]);
+    }
+    std::chrono::duration<double, std::milli> duration = std::chrono::steady_clock::now() - start;
+    std::cout << name << ": " << duration.count() << " ms (" << std::count(results.begin(), results.end(), true) << " accepted words)\n";
+    return results;
+}
+
+int main(int argc, char** argv) {
+    std::size_t numberWords = argc > 1 ? std::stoul(argv[1]) : 10000000;
+
+    auto dfa = LFDFA::loadFromFile(MATCHER_KIS_FILE);
+    std::set<std::string> Sp, Sm;
+    dfa->getSets(Sp, Sm);
+    std::vector<std::string> sample(Sp.begin(), Sp.end());
+    sample.insert(sample.end(), Sm.begin(), Sm.end());
+
+    std::mt19937 generator(42);
+    std::uniform_int_distribution<std::size_t> distribution(0, sample.size() - 1);
+    std::vector<std::vector<char>> words(numberWords);
+    for (auto &word : words) {
+        const std::string &chosen = sample[distribution(generator)];
+        word.assign(chosen.begin(), chosen.end());
+    }
+
+    CompiledDFA<char> compiled(*dfa);
+
+    const std::vector<bool> expected = measure("DFA::isAccepted", words, [&dfa](const std::vector<char> &word) { return dfa->isAccepted(word); });
+    const std::vector<std::pair<std::string, std::vector<bool>>> results = {
+        {"CompiledDFA", measure("CompiledDFA::isAccepted", words, [&compiled](const std::vector<char> &word) { return compiled.isAccepted(word); })},
+        {"switchMatcher", measure("switchMatcher::isAccepted", words, [](const std::vector<char> &word) { return switchMatcher::isAccepted(word); })},
+        {"tableMatcher", measure("tableMatcher::isAccepted", words, [](const std::vector<char> &word) { return tableMatcher::isAccepted(word); })}
+    };
+
+    // Every classifier must give the same result as the interpreted DFA on every word
+    for (const auto &result : results) {
+        auto mismatch = std::mismatch(expected.begin(), expected.end(), result.second.begin());
+        if (mismatch.first != expected.end()) {
+            const auto &word = words[mismatch.first - expected.begin()];
+            std::cerr << result.first << " " << (*mismatch.second ? "accepts" : "rejects") << " the word \"" << std::string(word.begin(), word.end()) << "\" while DFA::isAccepted " << (*mismatch.first ? "accepts" : "rejects") << " it\n";
+            return 1;
+        }
+    }
+    return 0;
+}
\ No newline at end of file
@@ -0,0 +1,49 @@
+/**
+ * \file matcherGenerator.cpp
+ *
+ * Generates the matchers of a loop-free DFA for matcherBenchmarks.
+ *
+ * Usage: matcherGenerator kis-file output-directory
+ *
+ * The DFA is minimised and written in output-directory/switchMatcher.h (namespace switchMatcher) and output-directory/tableMatcher.h (namespace tableMatcher).
+ */
+
+#include <fstream>
+#include <iostream>
+
+#include "gsjj/DFAOperations.h"
+#include "gsjj/MatcherGenerator.h"
+
+#include "LFDFA.h"
+
+using namespace gsjj;
+
+/**
+ * Writes the matcher of the DFA in directory/name.h
+ */
+void writeMatcher(const DFA<char> &dfa, const std::string &directory, const std::string &name, MatcherStyle style) {
+    std::ofstream out(directory + "/" + name + ".h");
+    if (!out) {
+        throw std::runtime_error(directory + "/" + name + ".h could not be open");
+    }
+    out << generateMatcher(dfa, name, style);
+}
+
+int main(int argc, char** argv) {
+    if (argc != 3) {
+        std::cerr << "Usage: " << argv[0] << " kis-file output-directory\n";
+        return 1;
+    }
+
+    try {
+        auto dfa = minimise(*LFDFA::loadFromFile(argv[1]));
+        writeMatcher(*dfa, argv[2], "switchMatcher", MatcherStyle::Switch);
+        writeMatcher(*dfa, argv[2], "tableMatcher", MatcherStyle::Table);
+    }
+    catch (const std::exception &e) {
+        std::cerr << e.what() << "\n";
+        return 2;
+    }
+
+    return 0;
+}
\ No newline at end of file
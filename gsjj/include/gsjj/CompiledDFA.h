@@ -0,0 +1,531 @@
+/**
+ * \file CompiledDFA.h
+ *
+ * This file declares and implements the templated class CompiledDFA.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <map>
+#include <memory>
+#include <ostream>
+#include <set>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+#include "gsjj/DFA.h"
+#include "gsjj/MappedFile.h"
+
+namespace gsjj {
+    /**
+     * A read-only copy of a DFA, optimised to classify a large number of words.
+     *
+     * The transition function is stored in a dense table with one row per state and one column per symbol. Each entry is the number of the target state, stored on 8, 16 or 32 bits depending on the number of states (the smaller the table, the more of it fits in the cache). A symbol is translated into its column by a 256-entry array when the alphabet is a one-byte integral type (for example, a char), and by a map otherwise.
+     *
+     * The states of the DFA are renumbered from 1. The row 0 is a rejecting sink: the missing transitions of the DFA go to it, as does every symbol that does not appear in the DFA (column 0). A word that reaches the sink is rejected without reading its remaining symbols.
+     *
+     * The tables are stored in an immutable image that follows the binary format below. An automaton is saved by writing its image (see save) and loaded by mapping the file in memory and reading the tables where they are (see load). Copying a CompiledDFA shares the image. Every integer is little-endian:
+     *
+     * | Offset | Type | Content |
+     * | ------ | ---- | ------- |
+     * | 0 | char[8] | "GSJJDFA" followed by a null character |
+     * | 8 | uint32 | The version of the format (formatVersion) |
+     * | 12 | uint32 | The size of an entry of the table: 1, 2 or 4 |
+     * | 16 | uint32 | The number of rows n (the states and the sink) |
+     * | 20 | uint32 | The number of columns m (the symbols and the unknown symbols) |
+     * | 24 | uint32 | The row of the initial state |
+     * | 28 | uint32 | 0 (reserved) |
+     * | 32 | uint16[256] | The column of each byte |
+     * | 544 | uint8[] | The accepting rows: the bit i % 8 of the byte i / 8 is set iff the row i is accepting. The bitmap is padded with zeros to a multiple of 8 bytes |
+     * | ... | uint8, uint16 or uint32[n * m] | The table. The target of the row p with the symbol in the column c is at the index p * m + c |
+     *
+     * The DFA can be modified or destroyed once the CompiledDFA is built.
+     *
+     * @tparam Sigma The type of the alphabet (for example, char).
+     */
+    template<typename Sigma>
+    class CompiledDFA {
+    public:
+        /**
+         * Compiles the DFA
+         * @param dfa The DFA
+         */
+        explicit CompiledDFA(const DFA<Sigma> &dfa) {
+            // The states are sorted to obtain the same table whatever the order of their creation
+            std::vector<unsigned int> states(dfa.getStates());
+            std::sort(states.begin(), states.end());
+            std::vector<unsigned int> stateIndex(dfa.getTransitions().size(), sink);
+            for (unsigned int i = 0 ; i < states.size() ; i++) {
+                stateIndex[states[i]] = i + 1;
+            }
+            const unsigned int numberStates = states.size() + 1;
+
+            const auto &transitions = dfa.getTransitions();
+            std::set<Sigma> symbols;
+            for (const auto &row : transitions) {
+                for (const auto &transition : row) {
+                    symbols.insert(transition.first);
+                }
+            }
+            const unsigned int numberColumns = symbols.size() + 1;
+            unsigned int entrySize = 4;
+            if (numberStates <= (1u << 8)) {
+                entrySize = 1;
+            }
+            else if (numberStates <= (1u << 16)) {
+                entrySize = 2;
+            }
+
+            // The image is stored in 64-bit integers to be aligned like a mapped file
+            const std::size_t size = imageSize(numberStates, numberColumns, entrySize);
+            auto image = std::make_shared<std::vector<std::uint64_t>>((size + 7) / 8, 0);
+            unsigned char *data = reinterpret_cast<unsigned char*>(image->data());
+
+            std::memcpy(data, magic, sizeof(magic));
+            writeInteger(data + 8, formatVersion, 4);
+            writeInteger(data + 12, entrySize, 4);
+            writeInteger(data + 16, numberStates, 4);
+            writeInteger(data + 20, numberColumns, 4);
+            writeInteger(data + 24, stateIndex[dfa.getInitialState()], 4);
+
+            unsigned int column = 1;
+            for (const Sigma &a : symbols) {
+                addColumn(data, a, column, IsByteAlphabet());
+                column++;
+            }
+
+            for (unsigned int state : dfa.getAcceptingStates()) {
+                data[headerSize + stateIndex[state] / 8] |= 1u << (stateIndex[state] % 8);
+            }
+
+            // Every entry not given by the DFA goes to the sink (0)
+            unsigned char *table = data + headerSize + bitmapSize(numberStates);
+            for (unsigned int state = 0 ; state < transitions.size() ; state++) {
+                const std::size_t p = stateIndex[state];
+                for (const auto &transition : transitions[state]) {
+                    const std::size_t index = p * numberColumns + columnOf(data, transition.first, IsByteAlphabet());
+                    writeInteger(table + index * entrySize, stateIndex[transition.second], entrySize);
+                }
+            }
+
+            attach(image, data, size);
+        }
+
+        /**
+         * Loads a CompiledDFA saved by save.
+         *
+         * The file is mapped in memory (see MappedFile) and the words are classified directly from the mapping: nothing is copied and the loading time does not depend on the size of the table. The mapping stays alive as long as a copy of the CompiledDFA exists.
+         *
+         * The header and the size of the file are checked, but not the entries of the table: the file must come from save.
+         * @param filepath The path to the file
+         * @return The CompiledDFA
+         * @throws std::invalid_argument If the file can not be opened
+         * @throws std::runtime_error If the file is not a valid CompiledDFA
+         */
+        static CompiledDFA load(const std::string &filepath) {
+            static_assert(IsByteAlphabet::value, "Only the DFAs over a one-byte alphabet can be loaded");
+            auto file = std::make_shared<const MappedFile>(filepath);
+            CompiledDFA compiled;
+            compiled.attach(file, file->data(), file->size());
+            return compiled;
+        }
+
+        /**
+         * Writes the image of the CompiledDFA
+         * @param stream The stream, opened in binary mode
+         */
+        void write(std::ostream &stream) const {
+            static_assert(IsByteAlphabet::value, "Only the DFAs over a one-byte alphabet can be saved");
+            stream.write(reinterpret_cast<const char*>(m_image), m_imageSize);
+        }
+
+        /**
+         * Saves the CompiledDFA in a file that can be loaded by load
+         * @param filepath The path to the file
+         * @throws std::invalid_argument If the file can not be opened
+         */
+        void save(const std::string &filepath) const {
+            std::ofstream file(filepath, std::ios::binary);
+            if (!file) {
+                throw std::invalid_argument(filepath + " could not be open");
+            }
+            write(file);
+        }
+
+        /**
+         * Tests whether the word is accepted by the DFA
+         * @param word The word to test. It can be any container of Sigma (std::string, std::vector, std::list, ...)
+         * @return True iff the word is accepted by the DFA
+         * @tparam Word The type of the word
+         */
+        template<typename Word>
+        bool isAccepted(const Word &word) const {
+            switch (m_entrySize) {
+            case 1:
+                return acceptsWith(static_cast<const std::uint8_t*>(m_table), word);
+            case 2:
+                return acceptsWith(static_cast<const std::uint16_t*>(m_table), word);
+            default:
+                return acceptsWith(static_cast<const std::uint32_t*>(m_table), word);
+            }
+        }
+
+        /**
+         * Classifies every word in [first, last).
+         *
+         * The words are read by groups of numberLanes words at the same time: one symbol of each word in turn. Since the next state of a word does not depend on the others, the processor does not have to wait for a load from the table to complete before it starts the next one. When a word ends, the next word of the range takes its place.
+         * @param first The iterator to the first word
+         * @param last The iterator after the last word
+         * @return The i-th value is true iff the i-th word is accepted
+         * @tparam Iterator A forward iterator over words (see isAccepted)
+         */
+        template<typename Iterator>
+        std::vector<bool> classify(Iterator first, Iterator last) const {
+            switch (m_entrySize) {
+            case 1:
+                return classifyWith(static_cast<const std::uint8_t*>(m_table), first, last);
+            case 2:
+                return classifyWith(static_cast<const std::uint16_t*>(m_table), first, last);
+            default:
+                return classifyWith(static_cast<const std::uint32_t*>(m_table), first, last);
+            }
+        }
+
+        /**
+         * Classifies every word in [first, last) with several threads.
+         *
+         * The range is split in numberThreads consecutive parts of the same size, each one classified by classify(first, last) in its own thread.
+         * @param first The iterator to the first word
+         * @param last The iterator after the last word
+         * @param numberThreads The number of threads. If it is 0, std::thread::hardware_concurrency() is used
+         * @return The i-th value is true iff the i-th word is accepted
+         * @tparam Iterator A forward iterator over words (see isAccepted)
+         */
+        template<typename Iterator>
+        std::vector<bool> classify(Iterator first, Iterator last, unsigned int numberThreads) const {
+            if (numberThreads == 0) {
+                numberThreads = std::max(1u, std::thread::hardware_concurrency());
+            }
+            const std::size_t numberWords = std::distance(first, last);
+            // Below a few words per thread, starting the threads costs more than it saves
+            if (numberThreads == 1 || numberWords < 2 * numberThreads * numberLanes) {
+                return classify(first, last);
+            }
+
+            // std::vector<bool> packs the values: two threads can not write in the same vector
+            std::vector<std::vector<bool>> parts(numberThreads);
+            std::vector<std::thread> threads;
+            const std::size_t partSize = (numberWords + numberThreads - 1) / numberThreads;
+            Iterator begin = first;
+            std::size_t remaining = numberWords;
+            for (unsigned int t = 0 ; t < numberThreads && remaining > 0 ; t++) {
+                const std::size_t size = std::min(partSize, remaining);
+                Iterator end = std::next(begin, size);
+                threads.emplace_back([this, &parts, t, begin, end]() {
+                    parts[t] = classify(begin, end);
+                });
+                begin = end;
+                remaining -= size;
+            }
+            for (auto &thread : threads) {
+                thread.join();
+            }
+
+            std::vector<bool> accepted;
+            accepted.reserve(numberWords);
+            for (const auto &part : parts) {
+                accepted.insert(accepted.end(), part.begin(), part.end());
+            }
+            return accepted;
+        }
+
+        /**
+         * Returns the number of rows of the table (the states of the DFA and the sink)
+         * @return The number of rows
+         */
+        unsigned int getNumberOfStates() const {
+            return m_numberStates;
+        }
+
+        /**
+         * Returns the number of columns of the table (the symbols of the DFA and the column of the unknown symbols)
+         * @return The number of columns
+         */
+        unsigned int getNumberOfColumns() const {
+            return m_numberColumns;
+        }
+
+        /**
+         * Returns the size (in bytes) of an entry of the table: 1, 2 or 4
+         * @return The size of an entry
+         */
+        unsigned int getEntrySize() const {
+            return m_entrySize;
+        }
+
+    public:
+        /**
+         * The number of words read at the same time by classify
+         */
+        static constexpr unsigned int numberLanes = 8;
+        /**
+         * The version of the binary format written by save
+         */
+        static constexpr std::uint32_t formatVersion = 1;
+
+    private:
+        using IsByteAlphabet = std::integral_constant<bool, std::is_integral<Sigma>::value && sizeof(Sigma) == 1>;
+
+        /**
+         * The rejecting sink
+         */
+        static constexpr unsigned int sink = 0;
+        /**
+         * The first bytes of the image
+         */
+        static constexpr char magic[8] = {'G', 'S', 'J', 'J', 'D', 'F', 'A', '\0'};
+        /**
+         * The size of the fields before the accepting bitmap
+         */
+        static constexpr std::size_t headerSize = 32 + 2 * 256;
+
+        /**
+         * Keeps the image alive (a vector or a MappedFile)
+         */
+        std::shared_ptr<const void> m_owner;
+        /**
+         * The image and its size
+         */
+        const unsigned char *m_image;
+        std::size_t m_imageSize;
+        /**
+         * The number of rows
+         */
+        unsigned int m_numberStates;
+        /**
+         * The number of columns
+         */
+        unsigned int m_numberColumns;
+        /**
+         * The size of an entry
+         */
+        unsigned int m_entrySize;
+        /**
+         * The row of the initial state
+         */
+        unsigned int m_initialState;
+        /**
+         * The column of each byte, in the image
+         */
+        const std::uint16_t *m_byteColumns;
+        /**
+         * The accepting bitmap, in the image
+         */
+        const unsigned char *m_accepting;
+        /**
+         * The table, in the image
+         */
+        const void *m_table;
+        /**
+         * The column of each symbol for the alphabets that are not one-byte integral types
+         */
+        std::map<Sigma, unsigned int> m_columns;
+
+    private:
+        CompiledDFA() = default;
+
+        static std::size_t bitmapSize(unsigned int numberStates) {
+            return (numberStates + 63) / 64 * 8;
+        }
+
+        static std::size_t imageSize(unsigned int numberStates, unsigned int numberColumns, unsigned int entrySize) {
+            return headerSize + bitmapSize(numberStates) + static_cast<std::size_t>(numberStates) * numberColumns * entrySize;
+        }
+
+        static void writeInteger(unsigned char *destination, std::uint32_t value, unsigned int size) {
+            for (unsigned int i = 0 ; i < size ; i++) {
+                destination[i] = (value >> (8 * i)) & 0xFF;
+            }
+        }
+
+        static std::uint32_t readInteger(const unsigned char *source, unsigned int size) {
+            std::uint32_t value = 0;
+            for (unsigned int i = 0 ; i < size ; i++) {
+                value |= static_cast<std::uint32_t>(source[i]) << (8 * i);
+            }
+            return value;
+        }
+
+        /**
+         * Converts an integer read from the image to the byte order of the processor
+         */
+        template<typename T>
+        static T fromLittleEndian(T value) {
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+            T swapped = 0;
+            for (unsigned int i = 0 ; i < sizeof(T) ; i++) {
+                swapped = (swapped << 8) | ((value >> (8 * i)) & 0xFF);
+            }
+            return swapped;
+#else
+            return value;
+#endif
+        }
+
+        /**
+         * Reads the header of the image and points to its tables
+         * @throws std::runtime_error If the image is not valid
+         */
+        void attach(std::shared_ptr<const void> owner, const unsigned char *image, std::size_t size) {
+            if (size < headerSize || std::memcmp(image, magic, sizeof(magic)) != 0) {
+                throw std::runtime_error("The file does not contain a compiled DFA");
+            }
+            if (readInteger(image + 8, 4) != formatVersion) {
+                throw std::runtime_error("The version of the compiled DFA is not supported");
+            }
+            m_entrySize = readInteger(image + 12, 4);
+            m_numberStates = readInteger(image + 16, 4);
+            m_numberColumns = readInteger(image + 20, 4);
+            m_initialState = readInteger(image + 24, 4);
+            if ((m_entrySize != 1 && m_entrySize != 2 && m_entrySize != 4) || m_numberColumns == 0 || m_initialState >= m_numberStates || size != imageSize(m_numberStates, m_numberColumns, m_entrySize)) {
+                throw std::runtime_error("The compiled DFA is corrupted");
+            }
+
+            m_owner = std::move(owner);
+            m_image = image;
+            m_imageSize = size;
+            m_byteColumns = reinterpret_cast<const std::uint16_t*>(image + 32);
+            m_accepting = image + headerSize;
+            m_table = image + headerSize + bitmapSize(m_numberStates);
+        }
+
+        void addColumn(unsigned char *image, const Sigma &a, unsigned int column, std::true_type) {
+            writeInteger(image + 32 + 2 * static_cast<unsigned char>(a), column, 2);
+        }
+
+        void addColumn(unsigned char *, const Sigma &a, unsigned int column, std::false_type) {
+            m_columns[a] = column;
+        }
+
+        unsigned int columnOf(const unsigned char *image, const Sigma &a, std::true_type) const {
+            return readInteger(image + 32 + 2 * static_cast<unsigned char>(a), 2);
+        }
+
+        unsigned int columnOf(const unsigned char *, const Sigma &a, std::false_type) const {
+            return column(a, std::false_type());
+        }
+
+        unsigned int column(const Sigma &a, std::true_type) const {
+            return fromLittleEndian(m_byteColumns[static_cast<unsigned char>(a)]);
+        }
+
+        unsigned int column(const Sigma &a, std::false_type) const {
+            auto itr = m_columns.find(a);
+            if (itr == m_columns.end()) {
+                return 0;
+            }
+            return itr->second;
+        }
+
+        unsigned int column(const Sigma &a) const {
+            return column(a, IsByteAlphabet());
+        }
+
+        bool isAcceptingRow(unsigned int state) const {
+            return (m_accepting[state / 8] >> (state % 8)) & 1;
+        }
+
+        template<typename Entry, typename Word>
+        bool acceptsWith(const Entry *table, const Word &word) const {
+            unsigned int state = m_initialState;
+            for (const Sigma &a : word) {
+                state = fromLittleEndian(table[static_cast<std::size_t>(state) * m_numberColumns + column(a)]);
+                if (state == sink) {
+                    return false;
+                }
+            }
+            return isAcceptingRow(state);
+        }
+
+        template<typename Entry, typename Iterator>
+        std::vector<bool> classifyWith(const Entry *table, Iterator first, Iterator last) const {
+            using Word = typename std::iterator_traits<Iterator>::value_type;
+            using SymbolIterator = decltype(std::begin(std::declval<const Word&>()));
+
+            // A word being read
+            struct Lane {
+                SymbolIterator current;
+                SymbolIterator end;
+                std::size_t index;
+                unsigned int state;
+            };
+
+            std::vector<bool> accepted(std::distance(first, last), false);
+            std::size_t nextIndex = 0;
+            // Gives the next word to the lane. Returns false if there is none
+            auto load = [&](Lane &lane) {
+                if (first == last) {
+                    return false;
+                }
+                lane.current = std::begin(*first);
+                lane.end = std::end(*first);
+                lane.index = nextIndex++;
+                lane.state = m_initialState;
+                ++first;
+                return true;
+            };
+
+            std::array<Lane, numberLanes> lanes;
+            unsigned int numberActive = 0;
+            while (numberActive < numberLanes && load(lanes[numberActive])) {
+                numberActive++;
+            }
+
+            while (numberActive > 0) {
+                for (unsigned int l = 0 ; l < numberActive ; ) {
+                    Lane &lane = lanes[l];
+                    if (lane.current == lane.end || lane.state == sink) {
+                        accepted[lane.index] = isAcceptingRow(lane.state);
+                        if (!load(lane)) {
+                            // The active lanes stay at the front
+                            numberActive--;
+                            std::swap(lane, lanes[numberActive]);
+                            continue;
+                        }
+                    }
+                    else {
+                        lane.state = fromLittleEndian(table[static_cast<std::size_t>(lane.state) * m_numberColumns + column(*lane.current)]);
+                        ++lane.current;
+                    }
+                    l++;
+                }
+            }
+
+            return accepted;
+        }
+    };
+
+    template<typename Sigma>
+    constexpr unsigned int CompiledDFA<Sigma>::numberLanes;
+
+    template<typename Sigma>
+    constexpr std::uint32_t CompiledDFA<Sigma>::formatVersion;
+
+    template<typename Sigma>
+    constexpr unsigned int CompiledDFA<Sigma>::sink;
+
+    template<typename Sigma>
+    constexpr char CompiledDFA<Sigma>::magic[8];
+
+    template<typename Sigma>
+    constexpr std::size_t CompiledDFA<Sigma>::headerSize;
+}
\ No newline at end of file
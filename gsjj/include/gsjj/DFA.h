@@ -6,16 +6,17 @@
 
 #pragma once
 
-// These container hash the keys, therefore the average complexity is constant
-#include <unordered_set>
-// These container use a red-black tree, therefore the complexity is logarithmic
+#include <algorithm>
+#include <limits>
 #include <map>
 #include <vector>
 #include <list>
 #include <memory>
+#include <utility>
 
 #include <string>
 #include <sstream>
+#include <stdexcept>
 
 /**
  * The namespace of the library
@@ -33,10 +34,27 @@ namespace gsjj {
      * 
      * We make the assumption that \f$Q\f$ cannot be empty (because there must be at least the initial state).
      * 
+     * The states are used as indices: the storage grows up to the largest state, so the states should be numbered from 0 without holes (as the learning methods do). The transitions leaving a state are stored in a row sorted by symbol (see Row) and whether a state exists or is accepting is stored in a bit vector. Therefore, reading a symbol is a binary search in a small contiguous row and no accessor copies the DFA.
+     * 
      * @tparam Sigma The type of the alphabet (for example, char).
      */
     template<typename Sigma>
     class DFA {
+    public:
+        /**
+         * A transition: the symbol and the state where it ends
+         */
+        using Transition = std::pair<Sigma, unsigned int>;
+        /**
+         * The transitions leaving a state, sorted by symbol
+         */
+        using Row = std::vector<Transition>;
+
+        /**
+         * The value returned by getTransition when the transition does not exist
+         */
+        static constexpr unsigned int none = std::numeric_limits<unsigned int>::max();
+
     public:
         /**
          * Constructs the DFA.
@@ -45,10 +63,41 @@ namespace gsjj {
          * @param isAccepting Whether the initial state is accepting or not
          */
         DFA(unsigned int initial, bool isAccepting = false) {
-            m_states.insert(initial);
             m_initialState = initial;
-            if (isAccepting) {
-                m_acceptingStates.insert(initial);
+            addState(initial, isAccepting);
+        }
+
+        /**
+         * Constructs the DFA and reserves the memory for the states \f$0, ..., numberStates - 1\f$.
+         * 
+         * @param initial The initial state
+         * @param isAccepting Whether the initial state is accepting or not
+         * @param numberStates The number of states that will be added
+         * @param numberSymbols The number of transitions that will leave each state
+         * @see reserve
+         */
+        DFA(unsigned int initial, bool isAccepting, unsigned int numberStates, unsigned int numberSymbols = 0) {
+            reserve(numberStates, numberSymbols);
+            m_initialState = initial;
+            addState(initial, isAccepting);
+        }
+
+        /**
+         * Reserves the memory for the states \f$0, ..., numberStates - 1\f$ and for numberSymbols transitions leaving each of them.
+         * 
+         * The following calls to addState and addTransition that stay in these bounds do not allocate anything.
+         * @param numberStates The number of states
+         * @param numberSymbols The number of transitions leaving each state
+         */
+        void reserve(unsigned int numberStates, unsigned int numberSymbols = 0) {
+            m_states.reserve(numberStates);
+            if (m_isState.size() < numberStates) {
+                m_isState.resize(numberStates, false);
+                m_isAccepting.resize(numberStates, false);
+                m_transitions.resize(numberStates);
+            }
+            for (unsigned int state = 0 ; state < numberStates ; state++) {
+                m_transitions[state].reserve(numberSymbols);
             }
         }
 
@@ -60,9 +109,18 @@ namespace gsjj {
          * @param isAccepting Whether the new state is accepting or not
          */
         void addState(unsigned int state, bool isAccepting = false) {
-            m_states.insert(state); // The check if the state is already in the set is automatically done in the insert function
-            if (isAccepting) {
-                m_acceptingStates.insert(state);
+            if (state >= m_isState.size()) {
+                m_isState.resize(state + 1, false);
+                m_isAccepting.resize(state + 1, false);
+                m_transitions.resize(state + 1);
+            }
+            if (!m_isState[state]) {
+                m_isState[state] = true;
+                m_states.push_back(state);
+            }
+            if (isAccepting && !m_isAccepting[state]) {
+                m_isAccepting[state] = true;
+                m_acceptingStates.push_back(state);
             }
         }
 
@@ -70,25 +128,37 @@ namespace gsjj {
          * Adds a transition to the DFA.
          * 
          * If the DFA is in the state p and reads the given symbol, it goes to the state q.
-         * The function checks that delta(p, symbol) does not yet exist and that p and q exist.
+         * The function checks that p and q exist. If delta(p, symbol) already exists, it is replaced.
          * 
          * @param p The state where the transition starts
          * @param symbol The symbol to read to activate the transition
          * @param q The state where the transition ends
          */
         void addTransition(unsigned int p, Sigma symbol, unsigned int q) {
-            if (m_states.find(p) == m_states.end()) {
+            if (!isState(p)) {
                 std::ostringstream error;
                 error << p << " is not known when adding the transition " << p << " --" << symbol << "--> " << q;
                 throw std::out_of_range(error.str());
             }
-            else if (m_states.find(q) == m_states.end()) {
+            else if (!isState(q)) {
                 std::ostringstream error;
                 error << q << " is not known when adding the transition " << p << " --" << symbol << "--> " << q;
                 throw std::out_of_range(error.str());
             }
 
-            m_transitions[p][symbol] = q;
+            Row &row = m_transitions[p];
+            // The symbols are usually added in increasing order: the transition goes at the end of the row
+            if (row.empty() || row.back().first < symbol) {
+                row.emplace_back(symbol, q);
+                return;
+            }
+            auto itr = find(row, symbol);
+            if (itr != row.end() && !(symbol < itr->first)) {
+                itr->second = q;
+            }
+            else {
+                row.emplace(itr, symbol, q);
+            }
         }
 
         /**
@@ -96,24 +166,8 @@ namespace gsjj {
          * @param word The word to test
          * @return True iff the word is accepted by the DFA
          */
-        bool isAccepted(const std::list<Sigma>& word) {
-            unsigned int state = m_initialState;
-            for (const Sigma &a : word) {
-                auto itr = m_transitions.find(state);
-                if (itr == m_transitions.end()) {
-                    return false;
-                }
-                auto tran = itr->second.find(a);
-
-                if (tran != itr->second.end()) {
-                    state = tran->second;
-                }
-                else {
-                    return false;
-                }
-            }
-
-            return isAcceptingState(state);
+        bool isAccepted(const std::list<Sigma>& word) const {
+            return accepts(word);
         }
 
         /**
@@ -121,20 +175,8 @@ namespace gsjj {
          * @param word The word to test
          * @return True iff the word is accepted by the DFA
          */
-        bool isAccepted(const std::vector<Sigma> &word) {
-            unsigned int state = m_initialState;
-            for (const Sigma &a : word) {
-                auto tran = m_transitions.find(std::make_pair(state, a));
-
-                if (tran != m_transitions.end()) {
-                    state = tran->second;
-                }
-                else {
-                    return false;
-                }
-            }
-
-            return isAcceptingState(state);
+        bool isAccepted(const std::vector<Sigma> &word) const {
+            return accepts(word);
         }
 
         /**
@@ -145,6 +187,32 @@ namespace gsjj {
             return m_states.size();
         }
 
+        /**
+         * Returns the number of states that can be reached from the initial state
+         * 
+         * The other states can be removed without changing the language of the DFA
+         * @return The number of reachable states
+         */
+        unsigned int getNumberOfReachableStates() const {
+            std::vector<bool> reached(m_isState.size(), false);
+            reached[m_initialState] = true;
+            unsigned int numberReached = 1;
+            std::vector<unsigned int> toVisit = {m_initialState};
+            while (!toVisit.empty()) {
+                unsigned int state = toVisit.back();
+                toVisit.pop_back();
+
+                for (const Transition &transition : m_transitions[state]) {
+                    if (!reached[transition.second]) {
+                        reached[transition.second] = true;
+                        numberReached++;
+                        toVisit.push_back(transition.second);
+                    }
+                }
+            }
+            return numberReached;
+        }
+
         /**
          * Constructs a string that is the representation of the DFA in the DOT language.
          * @return The string
@@ -168,7 +236,7 @@ namespace gsjj {
          */
         template<typename T>
         std::unique_ptr<DFA<T>> convert(const std::map<Sigma, T> &conversionMap) const {
-            std::unique_ptr<DFA<T>> converted = std::make_unique<DFA<T>>(m_initialState, isAcceptingState(m_initialState));
+            std::unique_ptr<DFA<T>> converted = std::make_unique<DFA<T>>(m_initialState, isAcceptingState(m_initialState), m_isState.size());
 
             for (unsigned int state : m_states) {
                 if (state != m_initialState) {
@@ -176,16 +244,15 @@ namespace gsjj {
                 }
             }
 
-            for (auto transition : m_transitions) {
-                unsigned int p = transition.first;
-                for (auto t : transition.second) {
+            for (unsigned int p : m_states) {
+                for (const Transition &t : m_transitions[p]) {
                     T a = conversionMap.at(t.first);
                     unsigned int q = t.second;
                     converted->addTransition(p, a, q);
                 }
             }
 
-            return std::move(converted);
+            return converted;
         }
 
         /**
@@ -194,24 +261,24 @@ namespace gsjj {
          * @return True iff state is accepting
          */
         bool isAcceptingState(unsigned int state) const {
-            return m_acceptingStates.find(state) != m_acceptingStates.end();
+            return state < m_isAccepting.size() && m_isAccepting[state];
         }
 
         /**
-         * Returns the set of states in this DFA
+         * Returns the states in this DFA, in the order they were added
          * @return The states
          */
-        const std::unordered_set<unsigned int> &getStates() const {
+        const std::vector<unsigned int> &getStates() const {
             return m_states;
         }
 
         /**
-         * Returns the set of accepting states of this DFA.
+         * Returns the accepting states of this DFA, in the order they were marked as accepting.
          * 
-         * Note that every state in this set is also in getStates, of course
+         * Note that every state in this vector is also in getStates, of course
          * @return The accepting states
          */
-        const std::unordered_set<unsigned int> &getAcceptingStates() const {
+        const std::vector<unsigned int> &getAcceptingStates() const {
             return m_acceptingStates;
         }
 
@@ -228,40 +295,105 @@ namespace gsjj {
         /**
          * Returns the function delta.
          * 
-         * The map associates the state to a map. This map associates a symbol a to a state q.
+         * The i-th row contains the transitions leaving the state i, sorted by symbol. The rows of the numbers that are not states are empty.
+         * @return The rows
          */
-        const std::map<unsigned int, std::map<Sigma, unsigned int>> getTransitions() const {
+        const std::vector<Row> &getTransitions() const {
             return m_transitions;
         }
 
+        /**
+         * Returns the transitions leaving a state, sorted by symbol
+         * @param state The state. It must exist
+         * @return The row of the state
+         */
+        const Row &getTransitions(unsigned int state) const {
+            return m_transitions.at(state);
+        }
+
+        /**
+         * Returns \f$\delta(p, a)\f$
+         * @param p The state where the transition starts
+         * @param symbol The symbol
+         * @return The state where the transition ends, or none if the transition does not exist
+         */
+        unsigned int getTransition(unsigned int p, const Sigma &symbol) const {
+            if (p >= m_transitions.size()) {
+                return none;
+            }
+            const Row &row = m_transitions[p];
+            auto itr = find(row, symbol);
+            if (itr != row.end() && !(symbol < itr->first)) {
+                return itr->second;
+            }
+            return none;
+        }
+
         /**
          * Checks if the given state number is in the states set
          * @param state The state to check
          * @return True iff state is in the DFA
          */
         bool isState(unsigned int state) const {
-            return m_states.find(state) != m_states.end();
+            return state < m_isState.size() && m_isState[state];
         }
 
     private:
         /**
-         * The set \f$Q\f$.
+         * The set \f$Q\f$, in the order of addState.
          */
-        std::unordered_set<unsigned int> m_states;
+        std::vector<unsigned int> m_states;
+        /**
+         * Whether each number is in \f$Q\f$.
+         */
+        std::vector<bool> m_isState;
         /**
          * The initial state \f$q_0\f$.
          */
         unsigned int m_initialState;
         /**
-         * The \f$\delta\f$ function.
+         * The \f$\delta\f$ function: one row per state.
          */
-        std::map<unsigned int, std::map<Sigma, unsigned int>> m_transitions;
+        std::vector<Row> m_transitions;
         /**
          * The set \f$F\f$.
          */
-        std::unordered_set<unsigned int> m_acceptingStates;
+        std::vector<unsigned int> m_acceptingStates;
+        /**
+         * Whether each number is in \f$F\f$.
+         */
+        std::vector<bool> m_isAccepting;
 
     private:
+        /**
+         * Gives the first transition of the row whose symbol is not smaller than the given symbol
+         */
+        template<typename RowType>
+        static auto find(RowType &row, const Sigma &symbol) -> decltype(row.begin()) {
+            return std::lower_bound(row.begin(), row.end(), symbol, [](const Transition &transition, const Sigma &a) {
+                return transition.first < a;
+            });
+        }
+
+        /**
+         * Reads the word from the initial state
+         * @param word The word to test
+         * @return True iff the word is accepted by the DFA
+         * @tparam Word The type of the word
+         */
+        template<typename Word>
+        bool accepts(const Word &word) const {
+            unsigned int state = m_initialState;
+            for (const Sigma &a : word) {
+                state = getTransition(state, a);
+                if (state == none) {
+                    return false;
+                }
+            }
+
+            return isAcceptingState(state);
+        }
+
         /**
          * Processes the states of the DFA to create a dot file.
          * \param dot The stringstream in which the function must write
@@ -269,7 +401,7 @@ namespace gsjj {
         void process_states_dot(std::ostringstream& dot) const {
             // We must add one state to create the arrow indicating the initial state
             dot << "\tnode [shape=none, label=\"\"] qi\n";
-            for (int state : m_states) {
+            for (unsigned int state : m_states) {
                 dot << "\tnode [shape=";
                 // Accepting states are double circled
                 if (isAcceptingState(state)) {
@@ -291,14 +423,14 @@ namespace gsjj {
             // The arrow indicating the initial state
             dot << "\tqi -> q" << m_initialState << ";\n";
 
-            for (auto state : m_transitions) {
-                unsigned int start = state.first;
-                for (auto transition : state.second) {
-                    Sigma symbol = transition.first;
-                    unsigned int end = transition.second;
-                    dot << "\tq" << start << " -> q" << end << " [label=\"" << symbol << "\"];\n";
+            for (unsigned int start = 0 ; start < m_transitions.size() ; start++) {
+                for (const Transition &transition : m_transitions[start]) {
+                    dot << "\tq" << start << " -> q" << transition.second << " [label=\"" << transition.first << "\"];\n";
                 }
             }
         }
     };
+
+    template<typename Sigma>
+    constexpr unsigned int DFA<Sigma>::none;
 }
\ No newline at end of file
@@ -0,0 +1,327 @@
+/**
+ * \file DFAOperations.h
+ *
+ * This file declares and implements the minimisation of a DFA and the equivalence check between two DFAs.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <map>
+#include <memory>
+#include <numeric>
+#include <set>
+#include <vector>
+
+#include "gsjj/DFA.h"
+
+namespace gsjj {
+    /**
+     * Minimises a DFA with Hopcroft's algorithm, in \f$O(n \cdot |\Sigma| \cdot log(n))\f$.
+     *
+     * The alphabet is the set of the symbols used by the transitions of the DFA. A missing transition goes to a rejecting sink, just like in DFA::isAccepted. The states that can not be reached from the initial state are ignored.
+     *
+     * The states of the result are numbered in the order of a breadth-first search from the initial state (which is 0) that reads the symbols in increasing order. Therefore, two DFAs with the same language and the same alphabet give exactly the same minimal DFA.
+     * @param dfa The DFA to minimise
+     * @param complete If false, the states from which no word can be accepted are removed with their incoming transitions. If true, they are kept as one state and every transition is defined
+     * @return The minimal DFA
+     * @tparam Sigma The type of the alphabet
+     */
+    template<typename Sigma>
+    std::unique_ptr<DFA<Sigma>> minimise(const DFA<Sigma> &dfa, bool complete = false) {
+        // The symbols are numbered in increasing order
+        std::set<Sigma> symbolSet;
+        for (const auto &row : dfa.getTransitions()) {
+            for (const auto &transition : row) {
+                symbolSet.insert(transition.first);
+            }
+        }
+        const std::vector<Sigma> symbols(symbolSet.begin(), symbolSet.end());
+        const unsigned int numberSymbols = symbols.size();
+
+        // The reachable states are numbered from 0 in BFS order and the sink is the last state
+        std::vector<unsigned int> index(dfa.getTransitions().size(), DFA<Sigma>::none);
+        std::vector<unsigned int> states = {dfa.getInitialState()};
+        index[dfa.getInitialState()] = 0;
+        for (unsigned int i = 0 ; i < states.size() ; i++) {
+            for (const auto &transition : dfa.getTransitions(states[i])) {
+                if (index[transition.second] == DFA<Sigma>::none) {
+                    index[transition.second] = states.size();
+                    states.push_back(transition.second);
+                }
+            }
+        }
+        const unsigned int sink = states.size();
+        const unsigned int numberStates = states.size() + 1;
+
+        // delta[q * |Sigma| + a] is the state reached from q with the a-th symbol
+        std::vector<unsigned int> delta(static_cast<std::size_t>(numberStates) * numberSymbols, sink);
+        for (unsigned int q = 0 ; q < sink ; q++) {
+            unsigned int a = 0;
+            for (const auto &transition : dfa.getTransitions(states[q])) {
+                // Both the row and the symbols are sorted
+                while (symbols[a] < transition.first) {
+                    a++;
+                }
+                delta[q * numberSymbols + a] = index[transition.second];
+            }
+        }
+
+        // The states p such that delta(p, a) = q are at [inverseStart[q * |Sigma| + a], inverseStart[q * |Sigma| + a + 1]) in inverse
+        std::vector<unsigned int> inverseStart(static_cast<std::size_t>(numberStates) * numberSymbols + 1, 0);
+        for (unsigned int p = 0 ; p < numberStates ; p++) {
+            for (unsigned int a = 0 ; a < numberSymbols ; a++) {
+                inverseStart[delta[p * numberSymbols + a] * numberSymbols + a + 1]++;
+            }
+        }
+        std::partial_sum(inverseStart.begin(), inverseStart.end(), inverseStart.begin());
+        std::vector<unsigned int> inverse(inverseStart.back());
+        {
+            std::vector<unsigned int> next(inverseStart.begin(), inverseStart.end() - 1);
+            for (unsigned int p = 0 ; p < numberStates ; p++) {
+                for (unsigned int a = 0 ; a < numberSymbols ; a++) {
+                    inverse[next[delta[p * numberSymbols + a] * numberSymbols + a]++] = p;
+                }
+            }
+        }
+
+        // The partition: the states of the block B are at [blockStart[B], blockEnd[B]) in elements
+        // The first marked[B] states of a block are the ones marked by the current splitter
+        std::vector<unsigned int> elements(numberStates), location(numberStates), blockOf(numberStates);
+        std::vector<unsigned int> blockStart, blockEnd, marked;
+        {
+            unsigned int position = 0;
+            for (bool accepting : {true, false}) {
+                const unsigned int begin = position;
+                for (unsigned int q = 0 ; q < numberStates ; q++) {
+                    if ((q != sink && dfa.isAcceptingState(states[q])) == accepting) {
+                        elements[position] = q;
+                        location[q] = position;
+                        blockOf[q] = blockStart.size();
+                        position++;
+                    }
+                }
+                if (position != begin) {
+                    blockStart.push_back(begin);
+                    blockEnd.push_back(position);
+                    marked.push_back(0);
+                }
+            }
+        }
+
+        // The splitters (B, a) that must still be processed. Since the sink is rejecting, there is at least one block
+        std::vector<std::pair<unsigned int, unsigned int>> worklist;
+        std::vector<bool> inWorklist(blockStart.size() * numberSymbols, false);
+        // Only the smallest block is needed at the start
+        const unsigned int firstSplitter = (blockStart.size() == 2 && blockEnd[1] - blockStart[1] < blockEnd[0] - blockStart[0]) ? 1 : 0;
+        for (unsigned int a = 0 ; a < numberSymbols ; a++) {
+            worklist.emplace_back(firstSplitter, a);
+            inWorklist[firstSplitter * numberSymbols + a] = true;
+        }
+
+        std::vector<unsigned int> touched, splitterStates;
+        while (!worklist.empty()) {
+            const unsigned int splitter = worklist.back().first;
+            const unsigned int a = worklist.back().second;
+            worklist.pop_back();
+            inWorklist[splitter * numberSymbols + a] = false;
+
+            // We mark every state that goes to the splitter with a
+            // The marking moves the states inside their block, so the states of the splitter are copied first
+            splitterStates.assign(elements.begin() + blockStart[splitter], elements.begin() + blockEnd[splitter]);
+            for (unsigned int q : splitterStates) {
+                for (unsigned int j = inverseStart[q * numberSymbols + a] ; j < inverseStart[q * numberSymbols + a + 1] ; j++) {
+                    const unsigned int p = inverse[j];
+                    const unsigned int block = blockOf[p];
+                    const unsigned int firstUnmarked = blockStart[block] + marked[block];
+                    if (location[p] < firstUnmarked) {
+                        continue;
+                    }
+                    if (marked[block] == 0) {
+                        touched.push_back(block);
+                    }
+                    // p is swapped with the first unmarked state of its block
+                    const unsigned int other = elements[firstUnmarked];
+                    std::swap(elements[location[p]], elements[firstUnmarked]);
+                    location[other] = location[p];
+                    location[p] = firstUnmarked;
+                    marked[block]++;
+                }
+            }
+
+            // Every block that is partially marked is split: the marked states go to a new block
+            for (unsigned int block : touched) {
+                const unsigned int numberMarked = marked[block];
+                marked[block] = 0;
+                if (blockStart[block] + numberMarked == blockEnd[block]) {
+                    continue;
+                }
+
+                const unsigned int newBlock = blockStart.size();
+                blockStart.push_back(blockStart[block]);
+                blockEnd.push_back(blockStart[block] + numberMarked);
+                marked.push_back(0);
+                blockStart[block] += numberMarked;
+                for (unsigned int i = blockStart[newBlock] ; i < blockEnd[newBlock] ; i++) {
+                    blockOf[elements[i]] = newBlock;
+                }
+
+                inWorklist.resize(blockStart.size() * numberSymbols, false);
+                const bool newIsSmaller = numberMarked < blockEnd[block] - blockStart[block];
+                for (unsigned int b = 0 ; b < numberSymbols ; b++) {
+                    // If (block, b) must still be processed, both halves must be. Otherwise, the smallest half is enough
+                    unsigned int added = newBlock;
+                    if (!inWorklist[block * numberSymbols + b] && !newIsSmaller) {
+                        added = block;
+                    }
+                    worklist.emplace_back(added, b);
+                    inWorklist[added * numberSymbols + b] = true;
+                }
+            }
+            touched.clear();
+        }
+
+        // The blocks are numbered in BFS order. The block of the sink is dropped if the DFA must not be complete
+        const unsigned int sinkBlock = blockOf[sink];
+        std::vector<unsigned int> number(blockStart.size(), DFA<Sigma>::none);
+        std::vector<unsigned int> order = {blockOf[0]};
+        number[blockOf[0]] = 0;
+        for (unsigned int i = 0 ; i < order.size() ; i++) {
+            const unsigned int q = elements[blockStart[order[i]]];
+            for (unsigned int a = 0 ; a < numberSymbols ; a++) {
+                const unsigned int target = blockOf[delta[q * numberSymbols + a]];
+                if (number[target] == DFA<Sigma>::none && (complete || target != sinkBlock)) {
+                    number[target] = order.size();
+                    order.push_back(target);
+                }
+            }
+        }
+
+        auto isAccepting = [&](unsigned int block) {
+            const unsigned int q = elements[blockStart[block]];
+            return q != sink && dfa.isAcceptingState(states[q]);
+        };
+        std::unique_ptr<DFA<Sigma>> minimal = std::make_unique<DFA<Sigma>>(0, isAccepting(order[0]), order.size(), numberSymbols);
+        for (unsigned int i = 1 ; i < order.size() ; i++) {
+            minimal->addState(i, isAccepting(order[i]));
+        }
+        for (unsigned int i = 0 ; i < order.size() ; i++) {
+            const unsigned int q = elements[blockStart[order[i]]];
+            for (unsigned int a = 0 ; a < numberSymbols ; a++) {
+                const unsigned int block = blockOf[delta[q * numberSymbols + a]];
+                // The sink block has a number if it contains the initial state
+                if (number[block] != DFA<Sigma>::none && (complete || block != sinkBlock)) {
+                    minimal->addTransition(i, symbols[a], number[block]);
+                }
+            }
+        }
+        return minimal;
+    }
+
+    /**
+     * Searches a shortest word accepted by exactly one of the two DFAs, with the algorithm of Hopcroft and Karp.
+     *
+     * The pairs of states (one from each DFA) are visited in breadth-first order from the pair of initial states. A union-find structure merges the states assumed to be equivalent, so each state is visited at most once and the complexity is almost linear in the number of states times the size of the alphabet. A missing transition goes to a rejecting sink, just like in DFA::isAccepted.
+     * @param first The first DFA
+     * @param second The second DFA
+     * @param word If a word is found, it is stored in this vector
+     * @return True iff the languages of the DFAs are different (and word was filled)
+     * @tparam Sigma The type of the alphabet
+     */
+    template<typename Sigma>
+    bool findDistinguishingWord(const DFA<Sigma> &first, const DFA<Sigma> &second, std::vector<Sigma> &word) {
+        // The alphabet is the union of both alphabets
+        std::set<Sigma> symbolSet;
+        for (const DFA<Sigma> *dfa : {&first, &second}) {
+            for (const auto &row : dfa->getTransitions()) {
+                for (const auto &transition : row) {
+                    symbolSet.insert(transition.first);
+                }
+            }
+        }
+        const std::vector<Sigma> symbols(symbolSet.begin(), symbolSet.end());
+
+        // The states of the first DFA are [0, firstSink], where firstSink is its sink. The states of the second DFA (and its sink) follow
+        const unsigned int firstSink = first.getTransitions().size();
+        const unsigned int secondSink = firstSink + 1 + second.getTransitions().size();
+        auto isAccepting = [&](unsigned int q) {
+            if (q < firstSink) {
+                return first.isAcceptingState(q);
+            }
+            else if (q > firstSink && q < secondSink) {
+                return second.isAcceptingState(q - firstSink - 1);
+            }
+            return false;
+        };
+        // The state reached from q with the symbol a. A sink loops on itself
+        auto target = [&](unsigned int q, const Sigma &a) {
+            if (q < firstSink) {
+                const unsigned int p = first.getTransition(q, a);
+                return p == DFA<Sigma>::none ? firstSink : p;
+            }
+            else if (q > firstSink && q < secondSink) {
+                const unsigned int p = second.getTransition(q - firstSink - 1, a);
+                return p == DFA<Sigma>::none ? secondSink : p + firstSink + 1;
+            }
+            return q;
+        };
+
+        std::vector<unsigned int> parent(secondSink + 1);
+        std::iota(parent.begin(), parent.end(), 0);
+        auto find = [&](unsigned int q) {
+            while (parent[q] != q) {
+                // Path halving
+                parent[q] = parent[parent[q]];
+                q = parent[q];
+            }
+            return q;
+        };
+
+        // A pair to visit, with the pair and the symbol it was reached from
+        struct Pair {
+            unsigned int p;
+            unsigned int q;
+            std::size_t previous;
+            unsigned int symbol;
+        };
+        std::vector<Pair> queue = {{first.getInitialState(), firstSink + 1 + second.getInitialState(), 0, 0}};
+        parent[find(queue[0].q)] = find(queue[0].p);
+
+        for (std::size_t i = 0 ; i < queue.size() ; i++) {
+            if (isAccepting(queue[i].p) != isAccepting(queue[i].q)) {
+                word.clear();
+                for (std::size_t j = i ; j != 0 ; j = queue[j].previous) {
+                    word.push_back(symbols[queue[j].symbol]);
+                }
+                std::reverse(word.begin(), word.end());
+                return true;
+            }
+
+            for (unsigned int a = 0 ; a < symbols.size() ; a++) {
+                const unsigned int p = target(queue[i].p, symbols[a]);
+                const unsigned int q = target(queue[i].q, symbols[a]);
+                const unsigned int rootP = find(p);
+                const unsigned int rootQ = find(q);
+                if (rootP != rootQ) {
+                    parent[rootQ] = rootP;
+                    queue.push_back({p, q, i, a});
+                }
+            }
+        }
+        return false;
+    }
+
+    /**
+     * Tests whether two DFAs accept the same language
+     * @param first The first DFA
+     * @param second The second DFA
+     * @return True iff the languages are the same
+     * @see findDistinguishingWord
+     * @tparam Sigma The type of the alphabet
+     */
+    template<typename Sigma>
+    bool areEquivalent(const DFA<Sigma> &first, const DFA<Sigma> &second) {
+        std::vector<Sigma> word;
+        return !findDistinguishingWord(first, second, word);
+    }
+}
\ No newline at end of file
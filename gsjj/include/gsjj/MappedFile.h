@@ -0,0 +1,52 @@
+/**
+ * \file MappedFile.h
+ *
+ * This file declares the class MappedFile.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+namespace gsjj {
+    /**
+     * A file mapped in memory, read-only.
+     *
+     * The file is mapped with mmap and MAP_SHARED: the pages are only read from the disk when they are used and the processes that map the same file share them. On Windows, the file is simply read in memory.
+     */
+    class MappedFile {
+    public:
+        /**
+         * Maps the file
+         * @param filepath The path to the file
+         * @throws std::invalid_argument If the file can not be opened or mapped
+         */
+        explicit MappedFile(const std::string &filepath);
+        MappedFile(const MappedFile&) = delete;
+        MappedFile &operator=(const MappedFile&) = delete;
+        ~MappedFile();
+
+        /**
+         * Returns the content of the file
+         * @return The first byte of the file (nullptr if the file is empty)
+         */
+        const unsigned char *data() const;
+        /**
+         * Returns the size of the file
+         * @return The size in bytes
+         */
+        std::size_t size() const;
+
+    private:
+        const unsigned char *m_data;
+        std::size_t m_size;
+#if defined(_WIN32)
+        /**
+         * The content of the file, since it is not mapped
+         */
+        std::vector<unsigned char> m_content;
+#endif
+    };
+}
\ No newline at end of file
@@ -0,0 +1,51 @@
+/**
+ * \file MatcherGenerator.h
+ *
+ * This file declares the functions that generate C++ code matching the words accepted by a DFA.
+ */
+
+#pragma once
+
+#include <string>
+
+#include "gsjj/DFA.h"
+
+namespace gsjj {
+    /**
+     * How the generated matcher walks the DFA
+     */
+    enum class MatcherStyle {
+        /**
+         * Each state is a label followed by a switch over the next symbol, whose cases jump to the label of the next state
+         */
+        Switch,
+        /**
+         * The transitions are stored in a constexpr table, with a static_assert checking that the columns of the table match the alphabet
+         */
+        Table
+    };
+
+    /**
+     * Gives the style with the given name ("switch" or "table")
+     * @param name The name of the style
+     * @return The style
+     * @throws std::invalid_argument If the name is unknown
+     */
+    MatcherStyle matcherStyleFromName(const std::string &name);
+
+    /**
+     * Generates a self-contained C++14 header that tests whether a word is accepted by the DFA.
+     *
+     * The header defines, in the namespace name:
+     *      - inline bool isAccepted(const char *word, std::size_t length)
+     *      - template<typename Word> bool isAccepted(const Word &word), for the contiguous containers of char with data() and size() (std::string, std::vector<char>, ...)
+     *
+     * Like DFA::isAccepted, a missing transition rejects the word. Only the states that can be reached from the initial state are generated: minimise the DFA first (see gsjj::minimise) to obtain the smallest code.
+     * @param dfa The DFA
+     * @param name The namespace of the generated functions. It must be a valid C++ identifier
+     * @param style How the DFA is walked
+     * @return The content of the header
+     * @throws std::invalid_argument If name is not a valid identifier
+     */
+    std::string generateMatcher(const DFA<char> &dfa, const std::string &name, MatcherStyle style = MatcherStyle::Switch);
+}
\ No newline at end of file
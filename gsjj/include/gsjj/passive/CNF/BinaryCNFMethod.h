@@ -6,6 +6,10 @@
 
 #pragma once
 
+#include <map>
+#include <utility>
+#include <vector>
+
 #include "bcsat/bc.hh"
  
 #include "gsjj/passive/Method.h"
@@ -33,19 +37,36 @@ namespace gsjj {
                 virtual void setStopTrigger(const std::chrono::seconds &timeLimit, std::atomic_bool &stopTrigger, const bool *stopPointer) override;
 
             protected:
-                typedef std::map<std::pair<std::string, unsigned int>, Gate*> m_mapType;
-
-            protected:
-                BinaryCNFMethod(const std::set<std::string> &SpSet, const std::set<std::string> &SmSet, const std::set<std::string> &SSet, const std::set<std::string> &prefixesSet, const std::set<char> &alphabetSet, unsigned int n);
+                BinaryCNFMethod(std::shared_ptr<const Sample> sample, unsigned int n);
 
                 virtual void createVariables();
                 virtual Gate* createFormula();
 
-                Gate* equal(const std::string &u, const std::string &v);
-                Gate* phi_different(const std::string &u, const std::string &v);
-                Gate* phi_not_q_i(const std::string &u, unsigned int i);
+                /**
+                 * Gives the gate that is true iff u and v reach the same state.
+                 *
+                 * The gate is created once for each unordered pair {u, v}
+                 */
+                Gate* equal(unsigned int u, unsigned int v);
+                /**
+                 * Gives the gate that is true iff u and v reach different states.
+                 *
+                 * The gate is created once for each unordered pair {u, v}
+                 */
+                Gate* phi_different(unsigned int u, unsigned int v);
+                Gate* phi_not_q_i(unsigned int u, unsigned int i);
+
+                /**
+                 * Creates a balanced tree of AND (or OR) gates over the given gates.
+                 *
+                 * A chain of binary gates would be as deep as the number of gates and bcsat handles the circuits recursively
+                 * @param gates The gates. It must not be empty
+                 * @param conjunction True for AND, false for OR
+                 * @return The root of the tree
+                 */
+                Gate* balanced(const std::vector<Gate*> &gates, bool conjunction);
 
-                unsigned int toState(const std::string &u) const;
+                unsigned int toState(unsigned int u) const;
 
                 std::unique_ptr<DFA<char>> toDFA() const;
 
@@ -56,7 +77,15 @@ namespace gsjj {
                  * \f$m = log_2(n)\f$
                  */
                 unsigned int m_binarySize;
-                m_mapType m_stateToVar;
+                /**
+                 * The j-th bit of the state reached by the prefix u is at the index \f$u \cdot m + j\f$ (u is the identifier of the prefix)
+                 */
+                std::vector<Gate*> m_stateToVar;
+                /**
+                 * The gates created by phi_different and equal, indexed by (min(u, v), max(u, v))
+                 */
+                std::map<std::pair<unsigned int, unsigned int>, Gate*> m_differentGates;
+                std::map<std::pair<unsigned int, unsigned int>, Gate*> m_equalGates;
             };
         }
     }
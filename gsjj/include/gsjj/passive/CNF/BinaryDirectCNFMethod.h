@@ -0,0 +1,97 @@
+/**
+ * \file BinaryDirectCNFMethod.h
+ *
+ * This file declares the binary method directly encoded in CNF.
+ */
+
+#pragma once
+
+#include <map>
+#include <utility>
+#include <vector>
+
+#include "gsjj/passive/CNF/SATCNFMethod.h"
+#include "gsjj/passive/MethodFactory.h"
+#include "gsjj/passive/StateTable.h"
+
+namespace gsjj {
+    namespace passive {
+        namespace CNF {
+            /**
+             * The Grinchtein, Leucker and Piterman's binary method, directly encoded in CNF.
+             *
+             * Unlike BinaryCNFMethod, no circuit is built and translated by bcsat: the clauses are given to Maple. The state reached by a prefix u is encoded with \f$m = \lceil log_2(n) \rceil\f$ bits \f$x_{u, j}\f$.
+             *
+             * Every pair of prefixes (u, v) that must be compared has an auxiliary variable \f$e_{u, v}\f$ which is true iff u and v reach the same state, and one variable per bit \f$b_{u, v, j} \Leftrightarrow (x_{u, j} \Leftrightarrow x_{v, j})\f$. They are shared by every constraint on the pair:
+             *  - \f$e_{u, v} \Rightarrow e_{ua, va}\f$ for the compatible pairs (see computePrefixPairs)
+             *  - \f$\neg e_{u, v}\f$ for the pairs in conflict and for every \f$u \in S_+, v \in S_-\f$
+             *
+             * The states \f$\geq n\f$ are forbidden with a comparison with \f$n - 1\f$ (at most m clauses by prefix).
+             *
+             * The method supports the incremental mode: when the number of states reaches a new power of two, only the new bits are created. The clauses that depend on m or n are retractable.
+             */
+            class BinaryDirectCNFMethod : public SATCNFMethod, public RegisterInFactory<BinaryDirectCNFMethod> {
+            public:
+                BinaryDirectCNFMethod() = delete;
+                ~BinaryDirectCNFMethod();
+
+                static std::string getFactoryName();
+
+            protected:
+                void createVariables(unsigned int firstNewState) override;
+                void createClauses(unsigned int firstNewState) override;
+                std::unique_ptr<DFA<char>> toDFA(const Minisat::vec<Minisat::lbool> &model) const override;
+
+                BinaryDirectCNFMethod(std::shared_ptr<const Sample> sample, unsigned int n);
+
+            private:
+                /**
+                 * The auxiliary variables of a pair of prefixes
+                 */
+                struct Equality {
+                    /**
+                     * e_{u, v}
+                     */
+                    Minisat::Var equal;
+                    /**
+                     * b_{u, v, j} for every bit j
+                     */
+                    std::vector<Minisat::Var> bits;
+                };
+
+                /**
+                 * Gives the index (in m_equalities) of the pair (u, v), and creates it if needed
+                 */
+                std::size_t equality(unsigned int u, unsigned int v);
+
+                /**
+                 * Computes the state reached by the prefix u in the model
+                 */
+                unsigned int toState(unsigned int u, const Minisat::vec<Minisat::lbool> &model) const;
+
+            private:
+                /**
+                 * \f$m = \lceil log_2(n) \rceil\f$
+                 */
+                unsigned int m_binarySize;
+                /**
+                 * The first bit that did not exist during the previous call to createVariables
+                 */
+                unsigned int m_firstNewBit;
+                /**
+                 * x_{u, j} is at the row u and the column j
+                 */
+                StateTable<Minisat::Var> m_bitVars;
+                /**
+                 * The pairs in the order of their creation
+                 */
+                std::vector<std::pair<unsigned int, unsigned int>> m_pairs;
+                std::vector<Equality> m_equalities;
+                /**
+                 * The index of each pair (u, v) with u < v
+                 */
+                std::map<std::pair<unsigned int, unsigned int>, std::size_t> m_pairIndex;
+            };
+        }
+    }
+}
@@ -0,0 +1,53 @@
+/**
+ * \file HeuleVerwerBFSCNFMethod.h
+ *
+ * This file declares the Heule and Verwer method with the BFS-based symmetry breaking of Ulyantsev, Zakirzyanov and Shalyto.
+ */
+
+#pragma once
+
+#include "gsjj/passive/CNF/HeuleVerwerCNFMethod.h"
+#include "gsjj/passive/MethodFactory.h"
+
+namespace gsjj {
+    namespace passive {
+        namespace CNF {
+            /**
+             * The Heule and Verwer method where the states must be numbered in the order of a breadth-first search of the DFA.
+             *
+             * The BFS starts from the initial state (the state 0) and reads the symbols in increasing order. Therefore, every DFA has exactly one encoding and the solver does not explore the \f$n!\f$ renumberings of the states.
+             *
+             * The clique given by Method::setSymmetryBreakingClique is ignored since it would contradict the BFS numbering.
+             *
+             * See Ulyantsev, Zakirzyanov and Shalyto, "BFS-Based Symmetry Breaking Predicates for DFA Identification" (LATA 2015).
+             */
+            class HeuleVerwerBFSCNFMethod : public HeuleVerwerCNFMethod, public RegisterInFactory<HeuleVerwerBFSCNFMethod> {
+            public:
+                HeuleVerwerBFSCNFMethod() = delete;
+                ~HeuleVerwerBFSCNFMethod();
+
+                static std::string getFactoryName();
+
+            protected:
+                /**
+                 * t_{i, j} (i < j) is true iff there is a transition from i to j. It's at the row i
+                 */
+                StateTable<Minisat::Var> m_tVars;
+                /**
+                 * p_{j, i} (i < j) is true iff i is the parent of j in the BFS tree (the smallest state with a transition to j). It's at the row j
+                 */
+                StateTable<Minisat::Var> m_pVars;
+                /**
+                 * m_{i, a, j} (i < j) is true iff a is the smallest symbol of the transitions from i to j. It's at the row i * |Sigma| + a
+                 */
+                StateTable<Minisat::Var> m_mVars;
+
+            protected:
+                void createVariables(unsigned int firstNewState) override;
+                void createSymmetryBreakingClauses(unsigned int firstNewState) override;
+
+                HeuleVerwerBFSCNFMethod(std::shared_ptr<const Sample> sample, unsigned int n);
+            };
+        }
+    }
+}
@@ -8,6 +8,7 @@
 
 #include "gsjj/passive/CNF/SATCNFMethod.h"
 #include "gsjj/passive/MethodFactory.h"
+#include "gsjj/passive/StateTable.h"
 
 namespace gsjj {
     namespace passive {
@@ -23,16 +24,33 @@ namespace gsjj {
                 static std::string getFactoryName();
 
             protected:
-                std::map<std::pair<std::string, unsigned int>, Minisat::Var> m_xVars;
-                std::map<std::tuple<unsigned int, char, unsigned int>, Minisat::Var> m_dVars;
-                std::map<unsigned int, Minisat::Var> m_fVars;
+                /**
+                 * x_{u, q}, at the row u (the identifier of the prefix)
+                 */
+                StateTable<Minisat::Var> m_xVars;
+                /**
+                 * d_{p, a, q}, at the row p * |Sigma| + a (the index of the symbol)
+                 */
+                StateTable<Minisat::Var> m_dVars;
+                /**
+                 * f_q, at the index q
+                 */
+                std::vector<Minisat::Var> m_fVars;
 
             protected:
-                void createVariables() override;
-                void createClauses() override;
+                void createVariables(unsigned int firstNewState) override;
+                void createClauses(unsigned int firstNewState) override;
                 std::unique_ptr<DFA<char>> toDFA(const Minisat::vec<Minisat::lbool> &model) const override;
 
-                HeuleVerwerCNFMethod(const std::set<std::string> &SpSet, const std::set<std::string> &SmSet, const std::set<std::string> &SSet, const std::set<std::string> &prefixesSet, const std::set<char> &alphabetSet, unsigned int n);
+                /**
+                 * Creates the clauses that break the symmetries between the states.
+                 * 
+                 * It's called at the end of createClauses, with the same parameter. By default, the prefixes of the clique are pinned (see Method::setSymmetryBreakingClique)
+                 * @param firstNewState The first state that did not exist during the previous call (0 the first time)
+                 */
+                virtual void createSymmetryBreakingClauses(unsigned int firstNewState);
+
+                HeuleVerwerCNFMethod(std::shared_ptr<const Sample> sample, unsigned int n);
             };
         }
     }
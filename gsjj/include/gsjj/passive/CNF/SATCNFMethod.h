@@ -6,6 +6,9 @@
 
 #include "gsjj/passive/Method.h"
 
+#include <vector>
+#include <string>
+
 namespace gsjj {
     namespace passive {
         /**
@@ -14,6 +17,32 @@ namespace gsjj {
          * These methodes use Maple.
          */
         namespace CNF {
+            /**
+             * The ways to encode "at most one of these literals is true" in CNF.
+             *
+             * For m literals:
+             *  - Pairwise: m(m - 1)/2 binary clauses, no new variable
+             *  - Sequential: the sequential counter of Sinz (a ladder), about 3m clauses and m new variables
+             *  - Commander: the commander encoding of Klieber and Kwon (groups of 3 literals), about 3.5m clauses and m/2 new variables
+             *  - Product: the 2-product encoding of Chen, about 2m + 4 sqrt(m) clauses and 2 sqrt(m) new variables
+             *
+             * See SATCNFMethod::addAtMostOne
+             */
+            enum class AtMostOneEncoding {
+                Pairwise,
+                Sequential,
+                Commander,
+                Product
+            };
+
+            /**
+             * Gives the encoding with the given name
+             * @param name "pairwise", "sequential", "commander" or "product"
+             * @return The encoding
+             * @throws std::invalid_argument If the name is unknown
+             */
+            AtMostOneEncoding atMostOneEncodingFromName(const std::string &name);
+
             /**
              * Base class for every method that relies on a SAT solver.
              * 
@@ -29,6 +58,26 @@ namespace gsjj {
                 std::unique_ptr<DFA<char>> constructDFA() override;
 
                 virtual void setStopTrigger(const std::chrono::seconds &timeLimit, std::atomic_bool &stopTrigger, const bool *stopPointer) override;
+
+                bool enableIncrementalMode() override;
+
+                bool incrementNumberOfStates() override;
+
+                /**
+                 * Chooses how the "at most one" constraints are encoded (see addAtMostOne).
+                 *
+                 * It must be called before the first call to solve(). By default, the encoding given to setDefaultAtMostOneEncoding is used.
+                 * @param encoding The encoding
+                 */
+                void setAtMostOneEncoding(AtMostOneEncoding encoding);
+
+                /**
+                 * Chooses the encoding of the "at most one" constraints of the methods constructed afterwards.
+                 *
+                 * By default, it's AtMostOneEncoding::Pairwise.
+                 * @param encoding The encoding
+                 */
+                static void setDefaultAtMostOneEncoding(AtMostOneEncoding encoding);
             
             protected:
                 /**
@@ -45,15 +94,40 @@ namespace gsjj {
                  * @param clause The clause to add
                  */
                 void addClause(const Minisat::vec<Minisat::Lit> &clause);
+                /**
+                 * Adds a new clause that only holds for the current number of states (for instance, "at least one of the n states").
+                 * 
+                 * In incremental mode, the clause is guarded by an activation literal which is assumed while solving and retired once the number of states grows.
+                 * Outside of the incremental mode, it's the same as addClause.
+                 * @param clause The clause to add
+                 */
+                void addRetractableClause(const Minisat::vec<Minisat::Lit> &clause);
+                /**
+                 * Adds the constraint "at most one of the literals is true", with the encoding chosen by setAtMostOneEncoding.
+                 *
+                 * In incremental mode, a group can grow with the number of states: the literals before firstNew must be the same (in the same order) as in the previous call for this group.
+                 * The pairwise and sequential encodings then only add the clauses involving the new literals. The other encodings can not be extended: they are rebuilt each time with retractable clauses (see addRetractableClause).
+                 * @param group An identifier of the group of literals, unique in the method
+                 * @param literals The literals
+                 * @param firstNew The index of the first literal that was not given in the previous call for this group (0 the first time)
+                 */
+                void addAtMostOne(std::size_t group, const Minisat::vec<Minisat::Lit> &literals, unsigned int firstNew = 0);
 
                 /**
-                 * Creates all needed variables for the method
+                 * Creates all needed variables for the method.
+                 * 
+                 * Only the variables that involve at least one state in [firstNewState, m_numberStates) must be created.
+                 * @param firstNewState The first state that did not exist during the previous call (0 the first time)
                  */
-                virtual void createVariables() = 0;
+                virtual void createVariables(unsigned int firstNewState) = 0;
                 /**
-                 * Creates all needed clauses for the method
+                 * Creates all needed clauses for the method.
+                 * 
+                 * Only the clauses that involve at least one state in [firstNewState, m_numberStates) must be created.
+                 * The clauses that depend on the whole set of states (and not only on some of them) must be added with addRetractableClause and must be created at each call.
+                 * @param firstNewState The first state that did not exist during the previous call (0 the first time)
                  */
-                virtual void createClauses() = 0;
+                virtual void createClauses(unsigned int firstNewState) = 0;
 
                 /**
                  * Effectively creates the DFA from the values of the variables in the given model
@@ -62,9 +136,31 @@ namespace gsjj {
                  */
                 virtual std::unique_ptr<DFA<char>> toDFA(const Minisat::vec<Minisat::lbool> &model) const = 0;
 
-                SATCNFMethod(const std::set<std::string> &SpSet, const std::set<std::string> &SmSet, const std::set<std::string> &SSet, const std::set<std::string> &prefixesSet, const std::set<char> &alphabetSet, unsigned int n);
+                SATCNFMethod(std::shared_ptr<const Sample> sample, unsigned int n);
 
             private:
+                /**
+                 * The pairwise encoding for the pairs that involve at least one literal from firstNew
+                 */
+                void addAtMostOnePairwise(const Minisat::vec<Minisat::Lit> &literals, unsigned int firstNew, bool retractable);
+                /**
+                 * The commander encoding, recursively on the commanders
+                 */
+                void addAtMostOneCommander(const Minisat::vec<Minisat::Lit> &literals);
+                /**
+                 * The 2-product encoding, recursively on the rows and the columns
+                 */
+                void addAtMostOneProduct(const Minisat::vec<Minisat::Lit> &literals);
+
+            private:
+                static AtMostOneEncoding s_defaultAtMostOneEncoding;
+
+                AtMostOneEncoding m_atMostOneEncoding;
+                /**
+                 * For the sequential encoding, the ladder variables of each group (s_i is true iff one of the literals 0, ..., i is true)
+                 */
+                std::vector<std::vector<Minisat::Var>> m_ladders;
+
                 /**
                  * The SAT solver.
                  * 
@@ -73,6 +169,29 @@ namespace gsjj {
                 std::unique_ptr<Minisat::SimpSolver> m_solver;
 
                 std::atomic_bool *mustStop;
+                /**
+                 * The value the solver watches when no stop trigger is given.
+                 * 
+                 * The solver keeps a reference to it, so it must live as long as the solver
+                 */
+                std::atomic_bool m_neverStop;
+
+                /**
+                 * Whether the solver is kept alive when the number of states grows
+                 */
+                bool m_incremental;
+                /**
+                 * In incremental mode, the literal guarding the retractable clauses of the current number of states
+                 */
+                Minisat::Lit m_activation;
+                /**
+                 * The assumptions given to the solver (only the activation literal in incremental mode)
+                 */
+                Minisat::vec<Minisat::Lit> m_assumptions;
+                /**
+                 * A buffer to add the activation literal to a retractable clause
+                 */
+                Minisat::vec<Minisat::Lit> m_guardedClause;
             };
         }
     }
@@ -2,6 +2,7 @@
 
 #include "gsjj/passive/CNF/SATCNFMethod.h"
 #include "gsjj/passive/MethodFactory.h"
+#include "gsjj/passive/StateTable.h"
 
 namespace gsjj {
     namespace passive {
@@ -19,24 +20,17 @@ namespace gsjj {
                 static std::string getFactoryName();
 
             protected:
-                void createVariables() override;
-                void createClauses() override;
+                void createVariables(unsigned int firstNewState) override;
+                void createClauses(unsigned int firstNewState) override;
                 std::unique_ptr<DFA<char>> toDFA(const Minisat::vec<Minisat::lbool> &model) const override;
 
-                UnaryCNFMethod(const std::set<std::string> &SpSet, const std::set<std::string> &SmSet, const std::set<std::string> &SSet, const std::set<std::string> &prefixesSet, const std::set<char> &alphabetSet, unsigned int n);
+                UnaryCNFMethod(std::shared_ptr<const Sample> sample, unsigned int n);
 
             private:
                 /**
-                 * The type of the map to use to know the Variable (in SAT) in function of (the prefix, the state in the DFA)
+                 * The variable (in SAT) in function of (the identifier of the prefix, the state in the DFA)
                  */
-                typedef std::map<std::pair<std::string, unsigned int>, Minisat::Var> states_map;
-                /**
-                 * A shortcut for std::pair<std::pair<std::string, unsigned int>, Var>
-                 */
-                typedef states_map::value_type state;
-
-            private:
-                states_map m_stateName;
+                StateTable<Minisat::Var> m_stateName;
             };
         }
     }
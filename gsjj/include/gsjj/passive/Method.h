@@ -1,12 +1,16 @@
 #pragma once
 
+#include <array>
 #include <set>
 #include <string>
+#include <vector>
 #include <memory>
 #include <chrono>
 #include <atomic>
 
 #include "gsjj/DFA.h"
+#include "gsjj/passive/utils.h"
+#include "gsjj/passive/Sample.h"
 
 namespace gsjj {
     /**
@@ -23,12 +27,16 @@ namespace gsjj {
         /**
          * An array with every possible method choice. Useful to iterate over the methods
          */
-        const std::array<const std::string, 8> allMethods = {
+        const std::array<const std::string, 12> allMethods = {
             "biermann",
+            "biermannBV",
             "unary",
             "binary",
+            "binaryDirect",
             "heule",
+            "heuleBFS",
             "neider",
+            "neiderBV",
             "unaryNonCNF",
             "binaryNonCNF",
             "heuleNonCNF"
@@ -94,31 +102,82 @@ namespace gsjj {
              */
             virtual void setStopTrigger(const std::chrono::seconds &timeLimit, std::atomic_bool &stopTrigger, const bool *stopPointer) = 0;
 
+            /**
+             * Asks the method to keep its solver alive when the number of states is increased (see incrementNumberOfStates).
+             * 
+             * It must be called before the first call to solve(). By default, a method does not support the incremental mode.
+             * @return True iff the method supports the incremental mode
+             */
+            virtual bool enableIncrementalMode();
+
+            /**
+             * Increases by one the number of states of the prospected DFA.
+             * 
+             * In incremental mode, the method only adds what is needed for the new state and keeps everything the solver already learnt.
+             * After this call, solve() must be called again.
+             * @return True iff it was possible to increase the number of states. If false, the method is left untouched
+             */
+            virtual bool incrementNumberOfStates();
+
+            /**
+             * Asks a running solve() to stop as soon as possible.
+             * 
+             * It can be called from another thread. The CNF and NonCNF methods already look at their stop trigger (see setStopTrigger) so, by default, it does nothing.
+             */
+            virtual void interrupt();
+
+            /**
+             * Gives a set of prefixes that must reach pairwise different states (see computeConflictClique).
+             * 
+             * The methods that support it force the i-th prefix of the clique to reach the state i. It breaks (a part of) the symmetries between the states.
+             * It must be called before the first call to solve(). By default, the clique is empty.
+             * @param clique The prefixes, pairwise in conflict
+             */
+            void setSymmetryBreakingClique(const std::vector<std::string> &clique);
+
         protected:
+            /**
+             * The sample, shared with the other methods constructed for it. The next members refer to its content
+             */
+            const std::shared_ptr<const Sample> m_sample;
             /**
              * The set of words to accept \f$S_+\f$
              */
-            const std::set<std::string> m_Sp;
+            const std::set<std::string> &m_Sp;
             /**
              * The set of words to reject \f$S_-\f$
              */
-            const std::set<std::string> m_Sm;
+            const std::set<std::string> &m_Sm;
+            /**
+             * The number of states in the DFA to construct.
+             * 
+             * It can only change through incrementNumberOfStates
+             */
+            unsigned int m_numberStates;
             /**
-             * The number of states in the DFA to construct
+             * \f$\Sigma\f$
              */
-            const unsigned int m_numberStates;
+            const std::set<char> &m_alphabet;
             /**
-             * In the code, \f$S = S_+ \cup S_-\f$
+             * The prefix tree of the sample. The methods identify the prefixes by their identifier in the tree
              */
-            const std::set<std::string> m_S;
+            const PrefixTree &m_prefixTree;
             /**
-             * \f$Pref(S_+ \cup S_-)\f$
+             * The identifiers in m_prefixTree of the words in \f$S_+\f$
              */
-            const std::set<std::string> m_prefixes;
+            const std::vector<unsigned int> &m_SpIds;
             /**
-             * \f$\Sigma\f$
+             * The identifiers in m_prefixTree of the words in \f$S_-\f$
+             */
+            const std::vector<unsigned int> &m_SmIds;
+            /**
+             * \f$\Sigma\f$, in increasing order. The index of a symbol is its position in this vector
              */
-            const std::set<char> m_alphabet;
+            const std::vector<char> &m_symbols;
+            /**
+             * The prefixes that must reach pairwise different states. The i-th prefix is pinned to the state i
+             */
+            std::vector<std::string> m_clique;
 
             bool m_triedSolve;
             bool m_hasSolution;
@@ -127,17 +186,41 @@ namespace gsjj {
             double m_cpuTimeEnd;
 
         protected:
+            /**
+             * Gives the pairs of prefixes concerned by the determinism constraints (see computePrefixPairs).
+             * 
+             * They are computed once for the sample (see Sample::getPrefixPairs).
+             * @return The pairs
+             */
+            const std::vector<PrefixPair> &prefixPairs() const {
+                return m_sample->getPrefixPairs();
+            }
+
+            /**
+             * Gives the index of a symbol of \f$\Sigma\f$ (its position in m_symbols)
+             * @param a The symbol
+             * @return The index
+             */
+            unsigned int symbolIndex(char a) const {
+                return m_sample->symbolIndex(a);
+            }
+
+            /**
+             * Creates the DFA from the state reached by every prefix, in a single pass over the prefix tree.
+             * 
+             * A state is accepting iff a word of \f$S_+\f$ reaches it. The transitions that are not read by any prefix are loops.
+             * @param states The state reached by every prefix, indexed by the identifier of the prefix
+             * @return An unique_ptr to the constructed DFA
+             */
+            std::unique_ptr<DFA<char>> dfaFromStates(const std::vector<unsigned int> &states) const;
+
             /**
              * Creates the method.
              * 
-             * @param SpSet The set of words to accept
-             * @param SmSet The set of words to reject
-             * @param SSet The union of SpSet and SmSet
-             * @param prefixesSet The prefixes of S
-             * @param alphabetSet The used alphabet
+             * @param sample The sample. It's shared, not copied
              * @param n The number of states in the prospected DFA
              */
-            Method(const std::set<std::string> &SpSet, const std::set<std::string> &SmSet, const std::set<std::string> &SSet, const std::set<std::string> &prefixesSet, const std::set<char> &alphabetSet, unsigned int n);
+            Method(std::shared_ptr<const Sample> sample, unsigned int n);
         };
     }
 }
\ No newline at end of file
@@ -4,8 +4,10 @@
 #include <string>
 #include <map>
 #include <functional>
+#include <vector>
 
 #include "gsjj/passive/Method.h"
+#include "gsjj/passive/SearchStrategy.h"
 
 namespace gsjj {
     namespace passive {
@@ -26,11 +28,7 @@ namespace gsjj {
              * The type of the constructor the registerMethod must receive
              */
             using MethodConstructor = std::function<MethodPtr(
-                const std::set<std::string>& Sp,
-                const std::set<std::string>& Sm,
-                const std::set<std::string>& S,
-                const std::set<std::string>& prefixes,
-                const std::set<char>& alphabet,
+                std::shared_ptr<const Sample> sample,
                 unsigned int n
             )>;
 
@@ -55,14 +53,10 @@ namespace gsjj {
              * 
              * @param name The name of the method to construct
              * @param n The number of states
-             * @param Sp The \f$S_+\f$ set
-             * @param Sm The \f$S_-\f$ set
-             * @param S The \f$S = S_+ \cup S_-\f$
-             * @param prefixes The prefixes set
-             * @param alphabet The alphabet
+             * @param sample The sample
              * @sa registerMethod, constructMethod
              */
-            static MethodPtr create(const std::string &name, unsigned int n, const std::set<std::string> &Sp, const std::set<std::string> &Sm, const std::set<std::string> &S, const std::set<std::string> &prefixes, const std::set<char> &alphabet);
+            static MethodPtr create(const std::string &name, unsigned int n, std::shared_ptr<const Sample> sample);
 
         private:
             static std::map<std::string, MethodConstructor> s_methodsMap;
@@ -99,18 +93,18 @@ namespace gsjj {
 
         template<typename T>
         bool RegisterInFactory<T>::s_registered = MethodFactory::registerMethod(T::getFactoryName(),
-            [](const std::set<std::string> &Sp, const std::set<std::string> &Sm, const std::set<std::string> &S, const std::set<std::string> &prefixes, const std::set<char> &alphabet, unsigned int n) -> MethodFactory::MethodPtr {
+            [](std::shared_ptr<const Sample> sample, unsigned int n) -> MethodFactory::MethodPtr {
                 class MethodImplemented : public T {
                 public:
-                    MethodImplemented(const std::set<std::string> &SpSet, const std::set<std::string> &SmSet, const std::set<std::string> &SSet, const std::set<std::string> &prefixesSet, const std::set<char> &alphabetSet, unsigned int n) : T(SpSet, SmSet, SSet, prefixesSet, alphabetSet, n) {}
+                    MethodImplemented(std::shared_ptr<const Sample> sample, unsigned int n) : T(sample, n) {}
                 };
 
-                return std::move(std::make_unique<MethodImplemented>(Sp, Sm, S, prefixes, alphabet, n));
+                return std::move(std::make_unique<MethodImplemented>(std::move(sample), n));
             }
         );
 
         /**
-         * Computes the alphabet and the prefixes set from Sp and Sm and constructs a method for a fixed number of states.
+         * Builds the Sample of (Sp, Sm) and constructs a method for a fixed number of states.
          * 
          * Sp and Sm must be disjoint.
          * @param name The name of the method to construct
@@ -125,23 +119,17 @@ namespace gsjj {
         /**
          * Constructs a method for a fixed number of states.
          * 
-         * Sp and Sm must be disjoint.
          * @param name The name of the method to construct
          * @param n The number of states
-         * @param Sp The \f$S_+\f$ set
-         * @param Sm The \f$S_-\f$ set
-         * @param S The \f$S = S_+ \cup S_-\f$ set. See passive::computeS
-         * @param prefixes The \f$Pref(S)\f$ set. See passive::computePrefixes
-         * @param alphabet The alphabet. See computeAlphabet
-         * @return A method to construct the DFA for the sample \f$(S_+, S_-)\f$
-         * @warning S can not be empty (and must be coherent with Sp and Sm)
+         * @param sample The sample. It's shared with the method, not copied
+         * @return A method to construct the DFA for the sample
          */
-        std::unique_ptr<Method> constructMethod(const std::string &name, unsigned int n, const std::set<std::string> &Sp, const std::set<std::string> &Sm, const std::set<std::string> &S, const std::set<std::string> &prefixes, const std::set<char> &alphabet);
+        std::unique_ptr<Method> constructMethod(const std::string &name, unsigned int n, std::shared_ptr<const Sample> sample);
 
         /**
-         * Computes the alphabet and the prefixes set from Sp and Sm and constructs a method with the smallest possible number of states.
+         * Builds the Sample of (Sp, Sm) and constructs a method with the smallest possible number of states.
          * 
-         * This uses a linear search to find the minimal number of states
+         * This uses a linear search to find the minimal number of states (see LinearSearch)
          * 
          * Sp and Sm must be disjoint.
          * @param name The name of the method to construct
@@ -149,28 +137,92 @@ namespace gsjj {
          * @param Sm The \f$S_-\f$ set
          * @param timeLimit The time in seconds the program can take to find the best possible method.
          * @param timeTaken If not nullptr, the total time used to solve the different formulas is written. It does NOT give the full CPU time to find the best number of states, juste the time used by the SAT/SMT solvers!
+         * @param incremental If true and if the method supports it, the same method is kept alive while the number of states grows (see Method::incrementNumberOfStates)
+         * @param numberThreads The number of numbers of states solved at the same time. If greater than 1, the next numbers of states are solved speculatively (see the constructMethod taking a strategy)
          * @return A method to construct the DFA for the sample \f$(S_+, S_-)\f$ and a boolean. The boolean is true iff the function did not reach the time limit.
          * @warning S can not be empty (and must be coherent with Sp and Sm)
          */
-        std::pair<std::unique_ptr<Method>, bool> constructMethod(const std::string &name, const std::set<std::string> &Sp, const std::set<std::string> &Sm, const std::chrono::seconds &timeLimit = std::chrono::seconds(0), long double *timeTaken = nullptr);
+        std::pair<std::unique_ptr<Method>, bool> constructMethod(const std::string &name, const std::set<std::string> &Sp, const std::set<std::string> &Sm, const std::chrono::seconds &timeLimit = std::chrono::seconds(0), long double *timeTaken = nullptr, bool incremental = false, unsigned int numberThreads = 1);
 
         /**
          * Constructs a method with the smallest possible number of states.
          * 
-         * This uses a linear search to find the minimal number of states
+         * This uses a linear search to find the minimal number of states (see LinearSearch)
+         * 
+         * @param name The name of the method to construct
+         * @param sample The sample. It's shared by every method constructed during the search
+         * @param timeLimit The time in milliseconds the program can take to find the best possible method.
+         * @param timeTaken If not nullptr, the total time used to solve the different formulas is written. It does NOT give the full CPU time to find the best number of states, juste the time used by the SAT/SMT solvers!
+         * @param incremental If true and if the method supports it, the same method is kept alive while the number of states grows (see Method::incrementNumberOfStates)
+         * @param numberThreads The number of numbers of states solved at the same time. If greater than 1, the next numbers of states are solved speculatively (see the constructMethod taking a strategy)
+         * @return A method to construct the DFA for the sample and a boolean. The boolean is true iff the function did not reach the time limit.
+         */
+        std::pair<std::unique_ptr<Method>, bool> constructMethod(const std::string &name, std::shared_ptr<const Sample> sample, const std::chrono::seconds &timeLimit = std::chrono::seconds(0), long double *timeTaken = nullptr, bool incremental = false, unsigned int numberThreads = 1);
+
+        /**
+         * Builds the Sample of (Sp, Sm) and constructs a method with the smallest possible number of states.
+         * 
+         * The numbers of states to try are chosen by the given strategy. At the end, the strategy holds every probe and the bounds it proved.
          * 
          * Sp and Sm must be disjoint.
          * @param name The name of the method to construct
          * @param Sp The \f$S_+\f$ set
          * @param Sm The \f$S_-\f$ set
-         * @param S \f$S = S_+ \cup S_-\f$. See passive::computeS
-         * @param prefixes The set of prefixes of \f$S\f$. See passive::computePrefixes
-         * @param alphabet The alphabet of \f$S\f$. See passive::computeAlphabet
-         * @param timeLimit The time in milliseconds the program can take to find the best possible method.
+         * @param strategy The search strategy
+         * @param timeLimit The time in seconds the program can take to find the best possible method.
          * @param timeTaken If not nullptr, the total time used to solve the different formulas is written. It does NOT give the full CPU time to find the best number of states, juste the time used by the SAT/SMT solvers!
-         * @return A method to construct the DFA for the sample \f$(S_+, S_-)\f$ and a boolean. The boolean is true iff the function did not reach the time limit.
+         * @param incremental If true and if the method supports it, a method is grown instead of being rebuilt when the next number of states is larger (see Method::incrementNumberOfStates)
+         * @param numberThreads The number of numbers of states solved at the same time. If greater than 1, the numbers of states are tried in increasing order from the lower bound, numberThreads at a time: a DFA with n states cancels every number above n and a proof that there is none cancels every number below n. In this mode, the strategy only records the probes and the bounds and the incremental mode is not used
+         * @return The method with the smallest number of states for which a DFA was found (or nullptr if none was found) and a boolean. The boolean is true iff the function did not reach the time limit.
          * @warning S can not be empty (and must be coherent with Sp and Sm)
          */
-        std::pair<std::unique_ptr<Method>, bool> constructMethod(const std::string &name, const std::set<std::string> &Sp, const std::set<std::string> &Sm, const std::set<std::string> &S, const std::set<std::string> &prefixes, const std::set<char> &alphabet, const std::chrono::seconds &timeLimit = std::chrono::seconds(0), long double *timeTaken = nullptr);
+        std::pair<std::unique_ptr<Method>, bool> constructMethod(const std::string &name, const std::set<std::string> &Sp, const std::set<std::string> &Sm, SearchStrategy &strategy, const std::chrono::seconds &timeLimit = std::chrono::seconds(0), long double *timeTaken = nullptr, bool incremental = false, unsigned int numberThreads = 1);
+
+        /**
+         * Constructs a method with the smallest possible number of states.
+         * 
+         * The numbers of states to try are chosen by the given strategy. At the end, the strategy holds every probe and the bounds it proved.
+         * 
+         * @param name The name of the method to construct
+         * @param sample The sample. It's shared by every method constructed during the search
+         * @param strategy The search strategy
+         * @param timeLimit The time in seconds the program can take to find the best possible method.
+         * @param timeTaken If not nullptr, the total time used to solve the different formulas is written. It does NOT give the full CPU time to find the best number of states, juste the time used by the SAT/SMT solvers!
+         * @param incremental If true and if the method supports it, a method is grown instead of being rebuilt when the next number of states is larger (see Method::incrementNumberOfStates)
+         * @param numberThreads The number of numbers of states solved at the same time. If greater than 1, the numbers of states are tried in increasing order from the lower bound, numberThreads at a time: a DFA with n states cancels every number above n and a proof that there is none cancels every number below n. In this mode, the strategy only records the probes and the bounds and the incremental mode is not used
+         * @return The method with the smallest number of states for which a DFA was found (or nullptr if none was found) and a boolean. The boolean is true iff the function did not reach the time limit.
+         */
+        std::pair<std::unique_ptr<Method>, bool> constructMethod(const std::string &name, std::shared_ptr<const Sample> sample, SearchStrategy &strategy, const std::chrono::seconds &timeLimit = std::chrono::seconds(0), long double *timeTaken = nullptr, bool incremental = false, unsigned int numberThreads = 1);
+
+        /**
+         * Builds the Sample of (Sp, Sm) and runs several methods at the same time to find the smallest possible number of states.
+         * 
+         * See the other constructMethodPortfolio for the details.
+         * @param names The names of the methods to run
+         * @param Sp The \f$S_+\f$ set
+         * @param Sm The \f$S_-\f$ set
+         * @param timeLimit The time in seconds the program can take to find the best possible method.
+         * @param winner If not nullptr, the name of the method that found the returned DFA is written
+         * @param incremental If true and if the methods support it, a method is grown instead of being rebuilt (see Method::incrementNumberOfStates)
+         * @return The method of the winner and a boolean. The boolean is true iff the function did not reach the time limit. If no method finished its search, the method with the smallest number of states for which a DFA was found (or nullptr if none was found) and false.
+         * @throws std::invalid_argument If names is empty or if a name is unknown
+         */
+        std::pair<std::unique_ptr<Method>, bool> constructMethodPortfolio(const std::vector<std::string> &names, const std::set<std::string> &Sp, const std::set<std::string> &Sm, const std::chrono::seconds &timeLimit = std::chrono::seconds(0), std::string *winner = nullptr, bool incremental = false);
+
+        /**
+         * Runs several methods at the same time to find the smallest possible number of states.
+         * 
+         * Every method runs in its own thread with a linear search. When a method proves that there is no DFA with n states, the other methods skip every number of states up to n.
+         * The first method to find the minimal number of states wins and the other methods are stopped (see Method::interrupt).
+         * 
+         * @param names The names of the methods to run
+         * @param sample The sample. It's shared by every method of the portfolio
+         * @param timeLimit The time in seconds the program can take to find the best possible method.
+         * @param winner If not nullptr, the name of the method that found the returned DFA is written
+         * @param incremental If true and if the methods support it, a method is grown instead of being rebuilt (see Method::incrementNumberOfStates)
+         * @return The method of the winner and a boolean. The boolean is true iff the function did not reach the time limit. If no method finished its search, the method with the smallest number of states for which a DFA was found (or nullptr if none was found) and false.
+         * @throws std::invalid_argument If names is empty or if a name is unknown
+         */
+        std::pair<std::unique_ptr<Method>, bool> constructMethodPortfolio(const std::vector<std::string> &names, std::shared_ptr<const Sample> sample, const std::chrono::seconds &timeLimit = std::chrono::seconds(0), std::string *winner = nullptr, bool incremental = false);
     }
 }
\ No newline at end of file
@@ -19,23 +19,20 @@ namespace gsjj {
                 static std::string getFactoryName();
 
             protected:
-                virtual bool createFormula(std::ostream &stream) override;
-                virtual std::unique_ptr<DFA<char>> toDFA(std::istream &stream) const override;
-                virtual std::string getFileName() const override;
+                virtual LimbooleNode *createFormula() override;
+                virtual std::unique_ptr<DFA<char>> toDFA() const override;
 
-                BinaryNonCNFMethod(const std::set<std::string> &SpSet, const std::set<std::string> &SmSet, const std::set<std::string> &SSet, const std::set<std::string> &prefixesSet, const std::set<char> &alphabetSet, unsigned int n);
+                BinaryNonCNFMethod(std::shared_ptr<const Sample> sample, unsigned int n);
+
+            private:
+                LimbooleNode *phi_different(unsigned int pref1, unsigned int pref2);
+                LimbooleNode *phi_not_q_i(unsigned int pref, unsigned int i);
 
             private:
-                std::string phi_different(std::string pref1, std::string pref2);
-                std::string phi_not_q_i(std::string pref, unsigned int i);
-                /**
-                 * The type of the map to use to know the Variable (in SAT) in function of (the prefix, the state in the DFA)
-                 */
-                typedef std::map<std::pair<std::string, unsigned int>, unsigned int> states_map;
                 /**
-                 * A shortcut for std::pair<std::string, unsigned int>
+                 * x_{u, j} is the j-th bit of the state reached by the prefix u. It's at the index u * m + j
                  */
-                typedef states_map::value_type state;
+                std::vector<LimbooleNode*> m_xVars;
             };
         }
     }
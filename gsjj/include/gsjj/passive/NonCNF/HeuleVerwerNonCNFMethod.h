@@ -6,8 +6,11 @@
 
 #pragma once
 
+#include <vector>
+
 #include "gsjj/passive/NonCNF/SATNonCNFMethod.h"
 #include "gsjj/passive/MethodFactory.h"
+#include "gsjj/passive/StateTable.h"
 
 namespace gsjj {
     namespace passive {
@@ -23,11 +26,24 @@ namespace gsjj {
                 static std::string getFactoryName();
 
             protected:
-                virtual bool createFormula(std::ostream &stream) override;
-                std::unique_ptr<DFA<char>> toDFA(std::istream &stream) const override;
-                virtual std::string getFileName() const override;
+                virtual LimbooleNode *createFormula() override;
+                std::unique_ptr<DFA<char>> toDFA() const override;
+
+                HeuleVerwerNonCNFMethod(std::shared_ptr<const Sample> sample, unsigned int n);
 
-                HeuleVerwerNonCNFMethod(const std::set<std::string> &SpSet, const std::set<std::string> &SmSet, const std::set<std::string> &SSet, const std::set<std::string> &prefixesSet, const std::set<char> &alphabetSet, unsigned int n);
+            private:
+                /**
+                 * x_{u, q} is true iff the prefix u reaches the state q. It's at the row u
+                 */
+                StateTable<LimbooleNode*> m_xVars;
+                /**
+                 * d_{p, a, q} is true iff the transition from p with a goes to q. It's at the row p * |Sigma| + a
+                 */
+                StateTable<LimbooleNode*> m_dVars;
+                /**
+                 * f_q is true iff q is final
+                 */
+                std::vector<LimbooleNode*> m_fVars;
             };
         }
     }
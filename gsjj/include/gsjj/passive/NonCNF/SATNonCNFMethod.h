@@ -1,7 +1,7 @@
 #pragma once
 
-#include <ostream>
 #include <atomic>
+#include <memory>
 
 #include "gsjj/passive/Method.h"
 
@@ -32,49 +32,95 @@ namespace gsjj {
 
                 virtual std::unique_ptr<DFA<char>> constructDFA() override;
 
+                /**
+                 * Writes the boolean formula in the limboole syntax.
+                 *
+                 * The formula is the one given to the SAT solver by solve (it is created if solve was not yet called). The output is written through a buffer, in a time linear in its size
+                 * @param fileName The name of the file in which to write
+                 * @return True iff a formula exists (it does not when the problem is trivial) and the file could be written
+                 */
+                bool writeFormula(const std::string &fileName);
+
                 virtual void setStopTrigger(const std::chrono::seconds &timeLimit, std::atomic_bool &stopTrigger, const bool *stopPointer) override;
 
             protected:
                 /**
-                 * Gives the name of the file in which the boolean formula must be written
-                 * @return The name of the file
+                 * Creates a new variable in the formula
+                 * @return The node of the variable
+                 */
+                LimbooleNode *newVariable();
+
+                /**
+                 * Creates the negation of a formula
+                 */
+                LimbooleNode *newNot(LimbooleNode *a);
+
+                /**
+                 * Creates the conjunction of two formulas.
+                 *
+                 * nullptr is the empty conjunction (true): it can be used to start a conjunction of many formulas
+                 */
+                LimbooleNode *newAnd(LimbooleNode *a, LimbooleNode *b);
+
+                /**
+                 * Creates the disjunction of two formulas.
+                 *
+                 * nullptr is the empty disjunction (false): it can be used to start a disjunction of many formulas
+                 */
+                LimbooleNode *newOr(LimbooleNode *a, LimbooleNode *b);
+
+                /**
+                 * Creates the formula a -> b
                  */
-                virtual std::string getFileName() const = 0;
+                LimbooleNode *newImplies(LimbooleNode *a, LimbooleNode *b);
 
                 /**
-                 * Reads the output of the SAT solver and checks if the formula was satisfiable or not
-                 * @return True iff the formula was satisfiable
+                 * Creates the formula a <-> b
                  */
-                bool isSatisfiable() const;
+                LimbooleNode *newIff(LimbooleNode *a, LimbooleNode *b);
 
                 /**
-                 * Creates the boolean formula (must not be in CNF) and writes it in the stream
-                 * @param stream The output stream in which to write
-                 * @return True iff it is possible to create the formula
+                 * Gives the value of a variable in the solution found by the SAT solver
+                 * @param variable The node of the variable (created by newVariable)
+                 * @return The value of the variable
                  */
-                virtual bool createFormula(std::ostream &stream) = 0;
+                bool value(LimbooleNode *variable) const;
+
+                /**
+                 * Creates the boolean formula (must not be in CNF) with newVariable, newAnd, and so on.
+                 *
+                 * It is called once by solve. The formula is built in memory and directly given to the SAT solver
+                 * @return The root of the formula, or nullptr if it is not possible to create the formula
+                 */
+                virtual LimbooleNode *createFormula() = 0;
 
                 /**
                  * Effectively creates the DFA.
                  * 
-                 * If this function is called, the boolean formula is satisfiable. The output of the SAT solver is given in the stream
+                 * If this function is called, the boolean formula is satisfiable. The values of the variables are given by value
                  */
-                virtual std::unique_ptr<DFA<char>> toDFA(std::istream &stream) const = 0;
+                virtual std::unique_ptr<DFA<char>> toDFA() const = 0;
 
-                SATNonCNFMethod(const std::set<std::string> &SpSet, const std::set<std::string> &SmSet, const std::set<std::string> &SSet, const std::set<std::string> &prefixesSet, const std::set<char> &alphabetSet, unsigned int n);
+                SATNonCNFMethod(std::shared_ptr<const Sample> sample, unsigned int n);
 
             protected:
                 const bool *mustStop;
 
             private:
                 /**
-                 * The name of the file in which to write the boolean formula
+                 * The formula and the SAT solver (recreated by each call to solve)
+                 */
+                std::unique_ptr<LimbooleManager, void (*)(LimbooleManager *)> m_manager;
+                /**
+                 * The root of the formula, or nullptr if it is not possible to create the formula
                  */
-                std::string getInputFile() const;
+                LimbooleNode *m_formula;
+
+            private:
                 /**
-                 * The name of the file in which the SAT solver writes
+                 * Creates a new manager and the formula
                  */
-                std::string getOutputFile() const;
+                void buildFormula();
             };
         }
     }
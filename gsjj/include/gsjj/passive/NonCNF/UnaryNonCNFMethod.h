@@ -2,6 +2,7 @@
 
 #include "gsjj/passive/NonCNF/SATNonCNFMethod.h"
 #include "gsjj/passive/MethodFactory.h"
+#include "gsjj/passive/StateTable.h"
 
 namespace gsjj {
     namespace passive {
@@ -19,11 +20,16 @@ namespace gsjj {
                 static std::string getFactoryName();
 
             protected:
-                virtual bool createFormula(std::ostream &stream) override;
-                std::unique_ptr<DFA<char>> toDFA(std::istream &stream) const override;
-                virtual std::string getFileName() const override;
+                virtual LimbooleNode *createFormula() override;
+                std::unique_ptr<DFA<char>> toDFA() const override;
 
-                UnaryNonCNFMethod(const std::set<std::string> &SpSet, const std::set<std::string> &SmSet, const std::set<std::string> &SSet, const std::set<std::string> &prefixesSet, const std::set<char> &alphabetSet, unsigned int n);
+                UnaryNonCNFMethod(std::shared_ptr<const Sample> sample, unsigned int n);
+
+            private:
+                /**
+                 * x_{u, q} is true iff the prefix u reaches the state q. It's at the row u
+                 */
+                StateTable<LimbooleNode*> m_xVars;
             };
         }
     }
@@ -0,0 +1,45 @@
+#pragma once
+
+#include "gsjj/passive/SMT/SMTMethod.h"
+#include "gsjj/passive/MethodFactory.h"
+
+namespace gsjj {
+    namespace passive {
+        namespace SMT {
+            /**
+             * Implements the Biermann and Feldman method with bit-vectors.
+             * 
+             * The state of every prefix is a bit-vector of \f$\lceil log_2(n) \rceil\f$ bits instead of an integer (see BiermannMethod). The problem stays in the QF_BV logic and CVC4 can bit-blast it.
+             * 
+             * In incremental mode, the number of states can only grow while the width of the bit-vectors is large enough.
+             */
+            class BiermannBVMethod : public SMTMethod, public RegisterInFactory<BiermannBVMethod> {
+            public:
+                BiermannBVMethod() = delete;
+                ~BiermannBVMethod();
+
+                static std::string getFactoryName();
+
+                bool incrementNumberOfStates() override;
+
+            protected:
+                void createVariables() override;
+                CVC4::Expr createConstraints() override;
+                CVC4::Expr createBounds() override;
+                std::unique_ptr<DFA<char>> toDFA();
+
+                BiermannBVMethod(std::shared_ptr<const Sample> sample, unsigned int n);
+
+            private:
+                /**
+                 * The width of the bit-vectors. It's 0 while the variables are not created
+                 */
+                unsigned int m_width;
+                /**
+                 * The variable of every prefix, indexed by the identifier of the prefix
+                 */
+                std::vector<CVC4::Expr> m_stateName;
+            };
+        }
+    }
+}
\ No newline at end of file
@@ -21,15 +21,16 @@ namespace gsjj {
             protected:
                 void createVariables() override;
                 CVC4::Expr createConstraints() override;
+                CVC4::Expr createBounds() override;
                 std::unique_ptr<DFA<char>> toDFA();
 
-                BiermannMethod(const std::set<std::string> &SpSet, const std::set<std::string> &SmSet, const std::set<std::string> &SSet, const std::set<std::string> &prefixesSet, const std::set<char> &alphabetSet, unsigned int n);
+                BiermannMethod(std::shared_ptr<const Sample> sample, unsigned int n);
 
             private:
-                typedef std::map<std::string, CVC4::Expr> statesMap;
-                
-            private:
-                statesMap m_stateName;
+                /**
+                 * The variable of every prefix, indexed by the identifier of the prefix
+                 */
+                std::vector<CVC4::Expr> m_stateName;
             };
         }
     }
@@ -0,0 +1,66 @@
+#pragma once
+
+#include "gsjj/passive/SMT/SMTMethod.h"
+#include "gsjj/passive/MethodFactory.h"
+
+namespace gsjj {
+    namespace passive {
+        namespace SMT {
+            /**
+             * The Neider and Jansen method with bit-vectors.
+             * 
+             * The states, the prefixes and the symbols are bit-vectors instead of integers (see NeiderJansenMethod):
+             *  - x maps a prefix to a state
+             *  - d maps a state and a symbol to a state (a binary function replaces the tuple datatype)
+             *  - f maps a state to a boolean (true iff the state is accepting)
+             * 
+             * The problem stays in the QF_UFBV logic and CVC4 can bit-blast it.
+             * 
+             * In incremental mode, the number of states can only grow while the width of the bit-vectors is large enough.
+             */
+            class NeiderJansenBVMethod : public SMTMethod, public RegisterInFactory<NeiderJansenBVMethod> {
+            public:
+                NeiderJansenBVMethod() = delete;
+                ~NeiderJansenBVMethod();
+
+                static std::string getFactoryName();
+
+                bool incrementNumberOfStates() override;
+
+            protected:
+                void createVariables() override;
+                CVC4::Expr createConstraints() override;
+                CVC4::Expr createBounds() override;
+                std::unique_ptr<DFA<char>> toDFA();
+
+                NeiderJansenBVMethod(std::shared_ptr<const Sample> sample, unsigned int n);
+
+            private:
+                /**
+                 * Gives the constant of the state i
+                 */
+                CVC4::Expr state(unsigned int i);
+                /**
+                 * Gives the expression d(i, a)
+                 */
+                CVC4::Expr transition(const CVC4::Expr &i, unsigned int a);
+
+            private:
+                /**
+                 * The width of the bit-vectors of the states. It's 0 while the variables are not created
+                 */
+                unsigned int m_width;
+                /**
+                 * The width of the bit-vectors of the symbols
+                 */
+                unsigned int m_symbolWidth;
+                /**
+                 * The expression x(u) of every prefix, indexed by the identifier of the prefix
+                 */
+                std::vector<CVC4::Expr> m_xOfPrefix;
+
+                CVC4::Expr f, x, d;
+            };
+        }
+    }
+}
\ No newline at end of file
@@ -19,16 +19,17 @@ namespace gsjj {
             protected:
                 void createVariables() override;
                 CVC4::Expr createConstraints() override;
+                CVC4::Expr createBounds() override;
                 std::unique_ptr<DFA<char>> toDFA();
 
-                NeiderJansenMethod(const std::set<std::string> &SpSet, const std::set<std::string> &SmSet, const std::set<std::string> &SSet, const std::set<std::string> &prefixesSet, const std::set<char> &alphabetSet, unsigned int n);
+                NeiderJansenMethod(std::shared_ptr<const Sample> sample, unsigned int n);
 
-            private:
-                typedef std::map<std::string, CVC4::Expr> prefToIntMap;
-                
             private:
                 std::vector<CVC4::Expr> m_variables;
-                prefToIntMap m_prefixToInt;
+                /**
+                 * The expression x(u) of every prefix, indexed by the identifier of the prefix
+                 */
+                std::vector<CVC4::Expr> m_xOfPrefix;
 
                 CVC4::Expr f, x, d;
                 CVC4::Expr zero, n;
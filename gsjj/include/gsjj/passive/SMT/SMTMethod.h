@@ -1,6 +1,7 @@
 #pragma once
 
 #include <map>
+#include <vector>
 
 #include <cvc4/cvc4.h>
 
@@ -28,6 +29,18 @@ namespace gsjj {
 
                 virtual void setStopTrigger(const std::chrono::seconds &timeLimit, std::atomic_bool &stopTrigger, const bool *stopPointer) override;
 
+                /**
+                 * CVC4 does not look at the stop trigger. We therefore interrupt the SMT engine
+                 */
+                void interrupt() override;
+
+                /**
+                 * The constraints that do not depend on the number of states are asserted once. Only the bounds (see createBounds) are pushed and popped.
+                 */
+                bool enableIncrementalMode() override;
+
+                bool incrementNumberOfStates() override;
+
             protected:
                 /**
                  * This must be used to create new variables, constants and expressions
@@ -38,23 +51,61 @@ namespace gsjj {
                  */
                 CVC4::SmtEngine m_SMTEngine;
 
+            private:
+                /**
+                 * True iff the engine is kept alive between the numbers of states
+                 */
+                bool m_incremental;
+                /**
+                 * True iff the constraints of createConstraints are asserted in the engine
+                 */
+                bool m_encoded;
+                /**
+                 * True iff the bounds for the current number of states are in a pushed context
+                 */
+                bool m_pushed;
+
             protected:
                 /**
                  * Creates all needed variables for the method
                  */
                 virtual void createVariables() = 0;
                 /**
-                 * Creates an unique expression describing the constraints of this method.
+                 * Creates an unique expression describing the constraints of this method that do not depend on the number of states.
                  * @return The expression
                  */
                 virtual CVC4::Expr createConstraints() = 0;
+                /**
+                 * Creates an unique expression forcing the values to describe one of the first m_numberStates states.
+                 * @return The expression
+                 */
+                virtual CVC4::Expr createBounds() = 0;
                 /**
                  * Effectively creates the DFA from the values of the variables in the SMT solver (see SMTMethod::m_SMTEngine)
                  * @return An unique_ptr to the constructed DFA
                  */
                 virtual std::unique_ptr<DFA<char>> toDFA() = 0;
 
-                SMTMethod(const std::set<std::string> &SpSet, const std::set<std::string> &SmSet, const std::set<std::string> &SSet, const std::set<std::string> &prefixesSet, const std::set<char> &alphabetSet, unsigned int n);
+                /**
+                 * Gives the width of the bit-vectors needed to represent the values 0, ..., numberValues - 1
+                 * @param numberValues The number of values
+                 * @return \f$\lceil log_2(numberValues) \rceil\f$, and at least 1
+                 */
+                static unsigned int bitWidth(unsigned int numberValues);
+                /**
+                 * Creates a single n-ary conjunction of the expressions, instead of a deep tree of binary conjunctions
+                 * @param expressions The expressions
+                 * @return The conjunction (true if there is no expression)
+                 */
+                CVC4::Expr conjunction(const std::vector<CVC4::Expr> &expressions);
+                /**
+                 * Gives the value of a bit-vector expression in the model of the SMT solver
+                 * @param expr The expression
+                 * @return The value, as an unsigned integer
+                 */
+                unsigned int bitVectorValue(const CVC4::Expr &expr);
+
+                SMTMethod(std::shared_ptr<const Sample> sample, unsigned int n);
             };
         }
     }
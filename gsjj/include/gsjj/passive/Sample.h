@@ -0,0 +1,106 @@
+#pragma once
+
+#include <array>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <string>
+#include <vector>
+
+#include "gsjj/passive/utils.h"
+
+namespace gsjj {
+    namespace passive {
+        /**
+         * A sample \f$(S_+, S_-)\f$ and everything the methods derive from it.
+         * 
+         * A sample is immutable. It's built once and shared (through a std::shared_ptr) by every method constructed for it, for every number of states and every thread. The derived data that is not always needed (the prefix pairs and the conflict clique) is computed on the first call and is thread-safe.
+         * 
+         * The set of prefixes \f$Pref(S)\f$ is only stored as a PrefixTree, whose size is linear in the total length of the words.
+         */
+        class Sample {
+        public:
+            /**
+             * Builds the sample
+             * @param Sp The set of words to accept
+             * @param Sm The set of words to reject
+             * @throws std::invalid_argument If a word is in both sets
+             */
+            Sample(std::set<std::string> Sp, std::set<std::string> Sm);
+
+            Sample(const Sample&) = delete;
+            Sample &operator=(const Sample&) = delete;
+
+            /**
+             * Gives the set of words to accept \f$S_+\f$
+             */
+            const std::set<std::string> &getSp() const;
+            /**
+             * Gives the set of words to reject \f$S_-\f$
+             */
+            const std::set<std::string> &getSm() const;
+            /**
+             * Gives \f$\Sigma\f$
+             */
+            const std::set<char> &getAlphabet() const;
+            /**
+             * Gives the prefix tree of the sample. The methods identify the prefixes by their identifier in the tree
+             */
+            const PrefixTree &getPrefixTree() const;
+            /**
+             * Gives the identifiers in the prefix tree of the words in \f$S_+\f$
+             */
+            const std::vector<unsigned int> &getSpIds() const;
+            /**
+             * Gives the identifiers in the prefix tree of the words in \f$S_-\f$
+             */
+            const std::vector<unsigned int> &getSmIds() const;
+            /**
+             * Gives \f$\Sigma\f$, in increasing order. The index of a symbol is its position in this vector
+             */
+            const std::vector<char> &getSymbols() const;
+
+            /**
+             * Gives the index of a symbol of \f$\Sigma\f$ (its position in getSymbols())
+             * @param a The symbol
+             * @return The index
+             */
+            unsigned int symbolIndex(char a) const {
+                return m_symbolIndex[static_cast<unsigned char>(a)];
+            }
+
+            /**
+             * Gives the pairs of prefixes concerned by the determinism constraints (see computePrefixPairs).
+             * 
+             * They are computed on the first call.
+             * @return The pairs
+             */
+            const std::vector<PrefixPair> &getPrefixPairs() const;
+
+            /**
+             * Gives a set of prefixes that are pairwise in conflict (see computeConflictClique).
+             * 
+             * It's computed on the first call.
+             * @return The clique, in the order the prefixes were found
+             */
+            const std::vector<std::string> &getConflictClique() const;
+
+        private:
+            const std::set<std::string> m_Sp;
+            const std::set<std::string> m_Sm;
+            const PrefixTree m_prefixTree;
+            std::vector<unsigned int> m_SpIds;
+            std::vector<unsigned int> m_SmIds;
+            std::vector<char> m_symbols;
+            /**
+             * The index of every symbol in m_symbols (indexed by the symbol as an unsigned char)
+             */
+            std::array<unsigned int, 256> m_symbolIndex;
+
+            mutable std::once_flag m_prefixPairsFlag;
+            mutable std::vector<PrefixPair> m_prefixPairs;
+            mutable std::once_flag m_cliqueFlag;
+            mutable std::vector<std::string> m_clique;
+        };
+    }
+}
\ No newline at end of file
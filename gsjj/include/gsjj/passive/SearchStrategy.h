@@ -0,0 +1,211 @@
+/**
+ * \file SearchStrategy.h
+ *
+ * This file declares the strategies used to seek the minimal number of states.
+ */
+
+#pragma once
+
+#include <vector>
+#include <string>
+#include <memory>
+
+namespace gsjj {
+    namespace passive {
+        /**
+         * A strategy to choose the numbers of states to try when seeking the minimal number of states.
+         *
+         * The strategy keeps the interval in which the minimal number of states lies:
+         *  - the lower bound is the smallest number of states that is not known to be unsatisfiable
+         *  - the upper bound is the smallest number of states that is known to be satisfiable
+         *
+         * The search is over when both bounds are equal.
+         *
+         * Every probe (number of states, result and time taken by the solver) is recorded.
+         *
+         * A strategy is used through constructMethod. It can not be shared between two searches running at the same time.
+         */
+        class SearchStrategy {
+        public:
+            /**
+             * One try of the search
+             */
+            struct Probe {
+                /**
+                 * The number of states of the probe
+                 */
+                unsigned int numberOfStates;
+                /**
+                 * Whether a DFA with numberOfStates states exists
+                 */
+                bool satisfiable;
+                /**
+                 * The time taken by the solver
+                 */
+                double time;
+            };
+
+        public:
+            SearchStrategy();
+            virtual ~SearchStrategy();
+
+            /**
+             * Resets the strategy for a new search.
+             * @param trivialUpperBound A number of states that is known to be satisfiable (for example, the number of prefixes)
+             * @param lowerBound A number of states that is known to be a lower bound (for example, the size of a clique of conflicting prefixes)
+             */
+            void start(unsigned int trivialUpperBound, unsigned int lowerBound = 1);
+
+            /**
+             * Gives the next number of states to try
+             * @return The number of states, or 0 if the search is over
+             */
+            unsigned int nextNumberOfStates();
+
+            /**
+             * Gives the result of a probe to the strategy.
+             * @param n The number of states of the probe
+             * @param satisfiable Whether a DFA with n states exists
+             * @param time The time taken by the solver
+             * @param usedStates If satisfiable, the number of states of the found DFA that are reachable (a DFA with usedStates states therefore exists)
+             */
+            void report(unsigned int n, bool satisfiable, double time, unsigned int usedStates);
+
+            /**
+             * Tests whether the minimal number of states is known
+             * @return True iff the search is over
+             */
+            bool isFinished() const;
+
+            /**
+             * Returns the smallest number of states that is not known to be unsatisfiable
+             * @return The lower bound
+             */
+            unsigned int getLowerBound() const;
+
+            /**
+             * Returns the smallest number of states that is known to be satisfiable
+             * @return The upper bound, or 0 if it's not yet known
+             */
+            unsigned int getUpperBound() const;
+
+            /**
+             * Returns every probe done since the last call to start, in order
+             * @return The probes
+             */
+            const std::vector<Probe> &getProbes() const;
+
+        protected:
+            /**
+             * Chooses the next number of states to try.
+             *
+             * It's only called when the search is not over. The returned number must be in [lower bound, upper bound) (if the upper bound is known).
+             * @return The number of states
+             */
+            virtual unsigned int choose() const = 0;
+
+            /**
+             * Called when a probe is reported, after the bounds are updated.
+             *
+             * By default, it does nothing
+             * @param n The number of states of the probe
+             * @param satisfiable Whether a DFA with n states exists
+             * @param usedStates If satisfiable, the number of reachable states of the found DFA
+             */
+            virtual void onReport(unsigned int n, bool satisfiable, unsigned int usedStates);
+
+            /**
+             * Tests whether the upper bound is known
+             * @return True iff a satisfiable number of states was found
+             */
+            bool hasUpperBound() const;
+
+        protected:
+            unsigned int m_lowerBound;
+            /**
+             * The lower bound given to start
+             */
+            unsigned int m_initialLowerBound;
+            /**
+             * 0 while no satisfiable number of states was found
+             */
+            unsigned int m_upperBound;
+            unsigned int m_trivialUpperBound;
+
+        private:
+            std::vector<Probe> m_probes;
+        };
+
+        /**
+         * Tries n = 1, 2, 3, ... (starting from the initial lower bound) until a DFA is found
+         */
+        class LinearSearch : public SearchStrategy {
+        protected:
+            unsigned int choose() const override;
+        };
+
+        /**
+         * Tries n = 1, 2, 4, 8, ... until a DFA is found and then performs a binary search between the last two tries.
+         * 
+         * If the initial lower bound b is not 1, it tries n = b, b + 1, b + 3, b + 7, ... instead
+         */
+        class ExponentialBinarySearch : public SearchStrategy {
+        protected:
+            unsigned int choose() const override;
+        };
+
+        /**
+         * Starts from an upper bound and decreases n until no DFA can be found.
+         *
+         * If the upper bound is unsatisfiable, it continues with n = upper bound + 1, upper bound + 2, ...
+         */
+        class DescendingSearch : public SearchStrategy {
+        public:
+            /**
+             * @param upperBound The first number of states to try. If 0, the number of prefixes is used
+             */
+            explicit DescendingSearch(unsigned int upperBound = 0);
+
+        protected:
+            unsigned int choose() const override;
+
+        private:
+            const unsigned int m_start;
+        };
+
+        /**
+         * Starts from an upper bound and, as long as DFAs are found, jumps right below the number of reachable states of the best DFA found so far.
+         *
+         * Most of the probes are therefore satisfiable. When the number of states just below the best DFA is unsatisfiable, the number of states of the best DFA is tried to get a method of the optimal size.
+         */
+        class SatFirstSearch : public SearchStrategy {
+        public:
+            /**
+             * @param upperBound The first number of states to try. If 0, the number of prefixes is used
+             */
+            explicit SatFirstSearch(unsigned int upperBound = 0);
+
+        protected:
+            unsigned int choose() const override;
+            void onReport(unsigned int n, bool satisfiable, unsigned int usedStates) override;
+
+        private:
+            const unsigned int m_start;
+            /**
+             * The smallest number of reachable states in the DFAs found so far (0 if none)
+             */
+            unsigned int m_bestUsed;
+        };
+
+        /**
+         * Constructs a search strategy from its name.
+         *
+         * The names are "linear", "exponential", "descending" and "satFirst".
+         * @param name The name of the strategy
+         * @param upperBound The upper bound given to the descending and SAT-first strategies (0 to use the number of prefixes)
+         * @return The strategy
+         * @throws std::invalid_argument If the name is unknown
+         */
+        std::unique_ptr<SearchStrategy> constructSearchStrategy(const std::string &name, unsigned int upperBound = 0);
+    }
+}
@@ -0,0 +1,80 @@
+/**
+ * \file StateTable.h
+ *
+ * This file declares and implements the templated class StateTable.
+ */
+
+#pragma once
+
+#include <vector>
+#include <algorithm>
+#include <cstddef>
+
+namespace gsjj {
+    namespace passive {
+        /**
+         * A table indexed by (row, state) stored in a single contiguous array.
+         *
+         * The entry (row, q) lives at the index \f$row \cdot n + q\f$ where \f$n\f$ is the number of states. The methods use it to find their variables with arithmetic instead of a lookup in a std::map. For example:
+         *  - \f$x_{u, q}\f$ is at the row \f$u\f$ (the identifier of the prefix in the PrefixTree)
+         *  - \f$d_{p, a, q}\f$ is at the row \f$p \cdot |\Sigma| + a\f$ (where \f$a\f$ is the index of the symbol)
+         *
+         * When the number of states grows (see Method::incrementNumberOfStates), resize moves the existing entries to their new index.
+         * @tparam T The type of the entries (for example, Minisat::Var)
+         */
+        template<typename T>
+        class StateTable {
+        public:
+            StateTable() :
+                m_rows(0),
+                m_states(0)
+            {
+            }
+
+            /**
+             * Changes the dimensions of the table.
+             *
+             * The entries that fit in the new dimensions are kept. The new entries are default-constructed.
+             * @param rows The number of rows
+             * @param states The number of states
+             */
+            void resize(std::size_t rows, unsigned int states) {
+                if (states == m_states) {
+                    m_values.resize(rows * states);
+                }
+                else {
+                    std::vector<T> values(rows * states);
+                    std::size_t keptRows = std::min(rows, m_rows);
+                    unsigned int keptStates = std::min(states, m_states);
+                    for (std::size_t row = 0 ; row < keptRows ; row++) {
+                        std::move(m_values.begin() + row * m_states, m_values.begin() + row * m_states + keptStates, values.begin() + row * states);
+                    }
+                    m_values = std::move(values);
+                }
+                m_rows = rows;
+                m_states = states;
+            }
+
+            T &operator()(std::size_t row, unsigned int q) {
+                return m_values[row * m_states + q];
+            }
+
+            const T &operator()(std::size_t row, unsigned int q) const {
+                return m_values[row * m_states + q];
+            }
+
+            std::size_t rows() const {
+                return m_rows;
+            }
+
+            unsigned int states() const {
+                return m_states;
+            }
+
+        private:
+            std::vector<T> m_values;
+            std::size_t m_rows;
+            unsigned int m_states;
+        };
+    }
+}
@@ -0,0 +1,51 @@
+/**
+ * \file Verification.h
+ *
+ * This file declares the verification of a DFA against a sample.
+ */
+
+#pragma once
+
+#include <string>
+#include <vector>
+
+#include "gsjj/DFA.h"
+#include "gsjj/passive/Sample.h"
+
+namespace gsjj {
+    namespace passive {
+        /**
+         * The words of a sample that a DFA does not classify correctly
+         */
+        struct Misclassified {
+            /**
+             * The words of \f$S_+\f$ rejected by the DFA
+             */
+            std::vector<std::string> rejected;
+            /**
+             * The words of \f$S_-\f$ accepted by the DFA
+             */
+            std::vector<std::string> accepted;
+
+            /**
+             * Tests whether the DFA is consistent with the sample
+             * @return True iff every word is correctly classified
+             */
+            bool empty() const {
+                return rejected.empty() && accepted.empty();
+            }
+        };
+
+        /**
+         * Verifies that a DFA accepts every word of \f$S_+\f$ and rejects every word of \f$S_-\f$.
+         *
+         * The prefix tree of the sample is walked level by level: the state reached by each prefix is computed once, from the state of its parent, and not once per word sharing this prefix. The nodes are read in the order of their identifiers, and each level is split in consecutive subtrees that are verified by different threads.
+         * Like DFA::isAccepted, a word that leaves the DFA through a missing transition is rejected.
+         * @param dfa The DFA
+         * @param sample The sample
+         * @param numberThreads The number of threads. If it is 0, std::thread::hardware_concurrency() is used
+         * @return The misclassified words, in breadth-first order (by length, then lexicographically)
+         */
+        Misclassified verify(const DFA<char> &dfa, const Sample &sample, unsigned int numberThreads = 0);
+    }
+}
\ No newline at end of file
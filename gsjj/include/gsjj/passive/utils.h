@@ -2,6 +2,7 @@
 
 #include <set>
 #include <string>
+#include <vector>
 
 namespace gsjj {
     namespace passive {
@@ -27,6 +28,185 @@ namespace gsjj {
          */
         std::set<char> computeAlphabet(const std::set<std::string> &S);
 
+        /**
+         * Tests whether two prefixes must reach different states in every DFA consistent with the sample.
+         * 
+         * It's the case if there exists a suffix \f$w\f$ such that \f$uw \in S_+\f$ and \f$vw \in S_-\f$ (or the opposite).
+         * @param u The first prefix
+         * @param v The second prefix
+         * @param Sp The \f$S_+\f$ set
+         * @param Sm The \f$S_-\f$ set
+         * @return True iff u and v are in conflict
+         */
+        bool areInConflict(const std::string &u, const std::string &v, const std::set<std::string> &Sp, const std::set<std::string> &Sm);
+
+        /**
+         * The prefix tree of a sample (also called augmented prefix tree acceptor, or APTA).
+         *
+         * Every node is a prefix of \f$S = S_+ \cup S_-\f$. The nodes have dense identifiers in breadth-first order: the root (the empty word) is 0 and the nodes are sorted by length, then lexicographically. Therefore, the parent of a node always has a smaller identifier.
+         *
+         * The tree is built in a single pass over the words. Its size is linear in the total length of the words (while \f$Pref(S)\f$ as a set of strings is quadratic in the length of the words).
+         */
+        class PrefixTree {
+        public:
+            /**
+             * The label of a node
+             */
+            enum class Label : char {
+                /**
+                 * The prefix is neither in \f$S_+\f$ nor in \f$S_-\f$
+                 */
+                Unknown,
+                /**
+                 * The prefix is in \f$S_+\f$
+                 */
+                Accept,
+                /**
+                 * The prefix is in \f$S_-\f$
+                 */
+                Reject
+            };
+
+            /**
+             * A node of the tree
+             */
+            struct Node {
+                /**
+                 * The identifier of the parent (PrefixTree::none for the root)
+                 */
+                unsigned int parent;
+                /**
+                 * The symbol read from the parent (unused for the root)
+                 */
+                char symbol;
+                /**
+                 * The label of the prefix
+                 */
+                Label label;
+                /**
+                 * The length of the prefix
+                 */
+                unsigned int depth;
+                /**
+                 * The identifiers of the children, sorted by symbol
+                 */
+                std::vector<unsigned int> children;
+            };
+
+            /**
+             * The identifier used when there is no such node
+             */
+            static const unsigned int none;
+
+        public:
+            /**
+             * Builds the prefix tree of \f$S_+ \cup S_-\f$
+             * @param Sp The \f$S_+\f$ set
+             * @param Sm The \f$S_-\f$ set
+             * @throws std::invalid_argument If a word is in both sets
+             */
+            PrefixTree(const std::set<std::string> &Sp, const std::set<std::string> &Sm);
+
+            /**
+             * Gives the number of nodes, that is, \f$|Pref(S)|\f$
+             * @return The number of nodes
+             */
+            std::size_t size() const;
+
+            /**
+             * Gives a node
+             * @param id The identifier of the node
+             * @return The node
+             */
+            const Node &operator[](unsigned int id) const;
+
+            /**
+             * Gives the child of a node for a symbol
+             * @param id The identifier of the node
+             * @param symbol The symbol
+             * @return The identifier of the child, or PrefixTree::none if there is no such child
+             */
+            unsigned int getChild(unsigned int id, char symbol) const;
+
+            /**
+             * Gives the node of a prefix
+             * @param prefix The prefix
+             * @return The identifier of the node, or PrefixTree::none if the word is not a prefix of \f$S\f$
+             */
+            unsigned int find(const std::string &prefix) const;
+
+            /**
+             * Rebuilds the prefix of a node
+             * @param id The identifier of the node
+             * @return The prefix
+             */
+            std::string getPrefix(unsigned int id) const;
+
+            /**
+             * Gives the symbols used in the words
+             * @return The alphabet
+             */
+            const std::set<char> &getAlphabet() const;
+
+            /**
+             * Tests whether two prefixes must reach different states in every DFA consistent with the sample.
+             *
+             * Both subtrees are walked at the same time, so the cost is at most the size of the smallest subtree.
+             * @param u The identifier of the first prefix
+             * @param v The identifier of the second prefix
+             * @return True iff u and v are in conflict
+             * @see passive::areInConflict
+             */
+            bool areInConflict(unsigned int u, unsigned int v) const;
+
+        private:
+            std::vector<Node> m_nodes;
+            std::set<char> m_alphabet;
+        };
+
+        /**
+         * Greedily computes a set of prefixes that are pairwise in conflict (a clique in the consistency graph).
+         * 
+         * The prefixes must reach pairwise different states. Therefore, the size of the clique is a lower bound on the number of states of any DFA consistent with the sample.
+         * The prefixes are considered in breadth-first order (by length, then lexicographically).
+         * @param tree The prefix tree of the sample
+         * @return The identifiers of the prefixes in the clique, in the order they were found
+         * @see PrefixTree::areInConflict
+         */
+        std::vector<unsigned int> computeConflictClique(const PrefixTree &tree);
+
+        /**
+         * Greedily computes a set of prefixes that are pairwise in conflict (a clique in the consistency graph).
+         * 
+         * See the version on a PrefixTree.
+         * @param Sp The \f$S_+\f$ set
+         * @param Sm The \f$S_-\f$ set
+         * @return The clique, in the order the prefixes were found
+         * @see areInConflict
+         */
+        std::vector<std::string> computeConflictClique(const std::set<std::string> &Sp, const std::set<std::string> &Sm);
+
+        /**
+         * Two different prefixes u < v such that ua and va are both prefixes for at least one symbol a
+         */
+        struct PrefixPair {
+            unsigned int u;
+            unsigned int v;
+            /**
+             * False iff u and v are in conflict (see PrefixTree::areInConflict) and can therefore not reach the same state
+             */
+            bool compatible;
+        };
+
+        /**
+         * Computes every pair of prefixes that is concerned by the determinism constraints "if u and v reach the same state, ua and va reach the same state".
+         * 
+         * A method only needs to write these constraints for the compatible pairs. For an incompatible pair, it can directly write that u and v reach different states: the determinism constraints then always hold.
+         * @param tree The prefix tree of the sample
+         * @return The pairs, sorted by u and then by v
+         */
+        std::vector<PrefixPair> computePrefixPairs(const PrefixTree &tree);
+
         /**
          * Reads the \f$S_+\f$ and \f$S_-\f$ sets from a file
          * @param inputFile The path to the file to read
@@ -63,7 +63,7 @@ Solver::Solver(std::atomic_bool &stopTrigger) : // Modified on 10 March 2019
 
     // Parameters (user settable):
     //
-    mustStop(stopTrigger) // Modified on 10 March 2019
+    mustStop(&stopTrigger) // Modified on 10 March 2019
   , drup_file        (NULL)
   , verbosity        (0)
   , step_size        (opt_step_size)
@@ -1070,7 +1070,8 @@ lbool Solver::search(int& nof_conflicts)
                 reduceDB(); }
 
             Lit next = lit_Undef;
-            /*while (decisionLevel() < assumptions.size()){
+            // Modified on 16 October 2026 to enable the assumptions again (needed by the incremental mode)
+            while (decisionLevel() < assumptions.size()){
                 // Perform user provided assumption:
                 Lit p = assumptions[decisionLevel()];
                 if (value(p) == l_True){
@@ -1085,7 +1086,7 @@ lbool Solver::search(int& nof_conflicts)
                 }
             }
 
-            if (next == lit_Undef)*/{
+            if (next == lit_Undef){
                 // New variable decision:
                 decisions++;
                 next = pickBranchLit();
@@ -1168,6 +1169,11 @@ lbool Solver::solve_()
 
     add_tmp.clear();
 
+    // Modified on 16 October 2026
+    // The previous call may have ended with one of the heaps empty (the variables are only put back in the heap of the last mode)
+    // Without this, a second call would immediately report a (wrong) model
+    rebuildOrderHeap();
+
     VSIDS = true;
     int init = 10000;
     while (status == l_Undef && init > 0 /*&& withinBudget()*/)
@@ -1177,11 +1183,11 @@ lbool Solver::solve_()
     // Search:
     int phase_allotment = 100;
     int curr_restarts = 0;
-    for (;!mustStop;){
+    for (;!*mustStop;){
         int weighted = phase_allotment;
         fflush(stdout);
 
-        while (status == l_Undef && weighted > 0 && !mustStop /*&& withinBudget()*/)
+        while (status == l_Undef && weighted > 0 && !*mustStop /*&& withinBudget()*/)
             if (VSIDS)
                 status = search(weighted);
             else{
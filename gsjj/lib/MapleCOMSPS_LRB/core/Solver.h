@@ -84,6 +84,7 @@ public:
     // Constructor/Destructor:
     //
     Solver(std::atomic_bool &stopTrigger); // Modified on 10 March 2019
+    void setStopTrigger(std::atomic_bool &stopTrigger) { mustStop = &stopTrigger; } // Added on 16 October 2026 to allow a solver to outlive its first stop trigger
     virtual ~Solver();
 
     // Problem specification:
@@ -220,7 +221,7 @@ protected:
         VarOrderLt(const vec<double>&  act) : activity(act) { }
     };
 
-    std::atomic<bool> &mustStop;            // Added on 10 March 2019 to allow us to stop the thread if the limit is reached
+    std::atomic<bool> *mustStop;            // Added on 10 March 2019 to allow us to stop the thread if the limit is reached (pointer since 16 October 2026, see setStopTrigger)
     // Solver state:
     //
     bool                ok;               // If FALSE, the constraints are already unsatisfiable. No part of the solver state may be used!
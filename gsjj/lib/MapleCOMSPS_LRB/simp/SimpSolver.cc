@@ -367,7 +367,7 @@ bool SimpSolver::backwardSubsumptionCheck(bool verbose)
     assert(decisionLevel() == 0);
 
 	// Modified on 9 April 2019
-    while ((subsumption_queue.size() > 0 || bwdsub_assigns < trail.size()) && !mustStop){
+    while ((subsumption_queue.size() > 0 || bwdsub_assigns < trail.size()) && !*mustStop){
 
         // Empty subsumption queue and return immediately on user-interrupt:
         if (asynch_interrupt){
@@ -659,11 +659,11 @@ bool SimpSolver::eliminate(bool turn_off_elim)
 
     grow = grow ? grow * 2 : 8;
 	// The for instructions were modified on 9 April 2019 to add && !mustStop
-    for (; grow < 10000 && !mustStop; grow *= 2){
+    for (; grow < 10000 && !*mustStop; grow *= 2){
         // Rebuild elimination variable heap.
-        for (int i = 0; i < clauses.size() && !mustStop; i++){
+        for (int i = 0; i < clauses.size() && !*mustStop; i++){
             const Clause& c = ca[clauses[i]];
-            for (int j = 0; j < c.size() && !mustStop; j++)
+            for (int j = 0; j < c.size() && !*mustStop; j++)
                 if (!elim_heap.inHeap(var(c[j])))
                     elim_heap.insert(var(c[j]));
                 else
@@ -722,11 +722,11 @@ bool SimpSolver::eliminate_()
     // Main simplification loop:
     //
 	// Modified on 9 April 2019
-    while ((n_touched > 0 || bwdsub_assigns < trail.size() || elim_heap.size() > 0) && !mustStop){
+    while ((n_touched > 0 || bwdsub_assigns < trail.size() || elim_heap.size() > 0) && !*mustStop){
 
         gatherTouchedClauses();
 		// Added on 9 April 2019
-        if (mustStop)
+        if (*mustStop)
             break;
         // printf("  ## (time = %6.2f s) BWD-SUB: queue = %d, trail = %d\n", cpuTime(), subsumption_queue.size(), trail.size() - bwdsub_assigns);
         if ((subsumption_queue.size() > 0 || bwdsub_assigns < trail.size()) && 
@@ -743,7 +743,7 @@ bool SimpSolver::eliminate_()
 
         // printf("  ## (time = %6.2f s) ELIM: vars = %d\n", cpuTime(), elim_heap.size());
 		// Modified on 9 April 2019
-        for (int cnt = 0; !elim_heap.empty() && !mustStop; cnt++){
+        for (int cnt = 0; !elim_heap.empty() && !*mustStop; cnt++){
             Var elim = elim_heap.removeMin();
             
             if (asynch_interrupt) break;
@@ -31,7 +31,7 @@ static const char *text_NI = "%s:%d: %s not implemented";
 
 
 BC::BC(std::atomic_bool &stopTrigger) : // Modified on 10 March 2019
-  mustStop(stopTrigger) // Modified on 10 March 2019
+  mustStop(&stopTrigger) // Modified on 10 March 2019
 {
   first_gate = 0;
   may_transform_input_gates = true;
@@ -48,11 +48,12 @@ class BC
   std::vector<Gate*> index_to_gate;
   std::vector<unsigned int> free_gate_indices;
 
-  std::atomic_bool &mustStop;   // Added on 10 March 2019
+  std::atomic_bool *mustStop;   // Added on 10 March 2019 (pointer since 17 October 2026, see setStopTrigger)
 
 
 public:
   BC(std::atomic_bool &stopTrigger); // Modified on 10 March 2019 to add a parameter used to stop the sat solver if the time limit is reached
+  void setStopTrigger(std::atomic_bool &stopTrigger) { mustStop = &stopTrigger; } // Added on 17 October 2026 to allow a circuit to outlive its first stop trigger
   ~BC();
 
   /**
@@ -218,7 +218,7 @@ int BC::minisat_solve(const bool perform_simplifications
 #if defined(MINISAT220CORE)
   solver = new Minisat::Solver();
 #elif defined(MINISAT220SIMP)
-  solver = new Minisat::SimpSolver(mustStop); // Modified on 10 March 2019 to force the SAT solver to stop when the time limit is reached
+  solver = new Minisat::SimpSolver(*mustStop); // Modified on 10 March 2019 to force the SAT solver to stop when the time limit is reached
 #else
 #error "Unknown MiniSAT version defined"
 #endif
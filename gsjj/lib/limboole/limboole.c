@@ -138,6 +138,7 @@ struct Mgr
   int dump;
   PicoSAT * picosat;
   LGL * lgl;
+  int variables; // Added on 16 October 2026
 };
 
 /*------------------------------------------------------------------------*/
@@ -1406,3 +1407,270 @@ int limboole (int argc, const char **argv, const bool *stopTrigger) // Modified
 
   return error != 0;
 }
+
+/*------------------------------------------------------------------------*/
+/* Added on 16 October 2026: the in-memory API (see limboole.h) */
+
+static const bool never_stop = false;
+
+LimbooleManager *
+limboole_new (const bool *stopTrigger)
+{
+  Mgr *mgr;
+
+  mgr = init ();
+  mgr->stopTrigger = stopTrigger ? stopTrigger : &never_stop;
+#ifdef LIMBOOLE_USE_LINGELING
+  mgr->use_lingeling = 1;
+#else
+  mgr->use_picosat = 1;
+#endif
+  mgr->check_satisfiability = 1;
+
+  return mgr;
+}
+
+void
+limboole_release (LimbooleManager * mgr)
+{
+  release (mgr);
+}
+
+LimbooleNode *
+limboole_variable (LimbooleManager * mgr)
+{
+  Node *n;
+
+  /* The variables have no name and are never looked up: they are only
+   * inserted in the chronological list (not in the hash table) */
+  n = (Node *) malloc (sizeof (*n));
+  memset (n, 0, sizeof (*n));
+  n->type = VAR;
+  n->idx = ++mgr->variables;	/* the name of the variable (see 'limboole_write') */
+  insert (mgr, n);
+
+  return n;
+}
+
+LimbooleNode *
+limboole_not (LimbooleManager * mgr, LimbooleNode * child)
+{
+  return op (mgr, NOT, child, 0);
+}
+
+LimbooleNode *
+limboole_and (LimbooleManager * mgr, LimbooleNode * c0, LimbooleNode * c1)
+{
+  return op (mgr, AND, c0, c1);
+}
+
+LimbooleNode *
+limboole_or (LimbooleManager * mgr, LimbooleNode * c0, LimbooleNode * c1)
+{
+  return op (mgr, OR, c0, c1);
+}
+
+LimbooleNode *
+limboole_implies (LimbooleManager * mgr, LimbooleNode * c0, LimbooleNode * c1)
+{
+  return op (mgr, IMPLIES, c0, c1);
+}
+
+LimbooleNode *
+limboole_iff (LimbooleManager * mgr, LimbooleNode * c0, LimbooleNode * c1)
+{
+  return op (mgr, IFF, c0, c1);
+}
+
+int
+limboole_sat (LimbooleManager * mgr, LimbooleNode * root)
+{
+  int res;
+
+  if (*mgr->stopTrigger)
+    return 0;
+
+  mgr->root = root;
+  connect_solver (mgr);
+  tseitin (mgr);
+
+  if (*mgr->stopTrigger)
+    return 0;
+
+  res = 0;
+#ifdef LIMBOOLE_USE_LINGELING
+  if (mgr->lgl)
+    res = lglsat (mgr->lgl);
+#endif
+#ifdef LIMBOOLE_USE_PICOSAT
+  if (mgr->picosat)
+    res = picosat_sat (mgr->picosat, -1);
+#endif
+
+  return res;
+}
+
+int
+limboole_value (LimbooleManager * mgr, LimbooleNode * variable)
+{
+  int val;
+
+  val = 0;
+#ifdef LIMBOOLE_USE_PICOSAT
+  if (mgr->picosat)
+    val = picosat_deref (mgr->picosat, variable->idx);
+#endif
+#ifdef LIMBOOLE_USE_LINGELING
+  if (mgr->lgl)
+    val = lglderef (mgr->lgl, variable->idx);
+#endif
+
+  return val > 0;
+}
+
+/*------------------------------------------------------------------------*/
+/* Added on 16 October 2026: a streaming writer for the in-memory formulas.
+ * Unlike 'pp_and', the top level conjunction is flattened with an explicit
+ * stack (the formulas built through the API are long chains of '&') and the
+ * output goes through a fixed size buffer.
+ */
+
+typedef struct Writer Writer;
+
+struct Writer
+{
+  FILE *file;
+  unsigned count;
+  char buffer[4096];
+};
+
+static void
+write_flush (Writer * writer)
+{
+  fwrite (writer->buffer, 1, writer->count, writer->file);
+  writer->count = 0;
+}
+
+static void
+write_char (Writer * writer, char ch)
+{
+  if (writer->count == sizeof (writer->buffer))
+    write_flush (writer);
+  writer->buffer[writer->count++] = ch;
+}
+
+static void
+write_str (Writer * writer, const char *str)
+{
+  while (*str)
+    write_char (writer, *str++);
+}
+
+static void
+write_int (Writer * writer, int value)
+{
+  char digits[16];
+  int i;
+
+  i = 0;
+  do
+    {
+      digits[i++] = '0' + value % 10;
+      value /= 10;
+    }
+  while (value);
+
+  while (i)
+    write_char (writer, digits[--i]);
+}
+
+static void
+write_aux (Writer * writer, Node * node, Type outer)
+{
+  int le, lt;
+
+  le = outer <= node->type;
+  lt = outer < node->type;
+
+  switch (node->type)
+    {
+    case NOT:
+      write_char (writer, '!');
+      write_aux (writer, node->data.as_child[0], node->type);
+      break;
+    case IMPLIES:
+      if (le)
+	write_char (writer, '(');
+      write_aux (writer, node->data.as_child[0], node->type);
+      write_str (writer, " -> ");
+      write_aux (writer, node->data.as_child[1], node->type);
+      if (le)
+	write_char (writer, ')');
+      break;
+    case OR:
+    case AND:
+    case IFF:
+      if (lt)
+	write_char (writer, '(');
+      write_aux (writer, node->data.as_child[0], node->type);
+      if (node->type == OR)
+	write_str (writer, " | ");
+      else if (node->type == AND)
+	write_str (writer, " & ");
+      else
+	write_str (writer, " <-> ");
+      write_aux (writer, node->data.as_child[1], node->type);
+      if (lt)
+	write_char (writer, ')');
+      break;
+    default:
+      write_char (writer, 'v');
+      write_int (writer, node->idx);
+      break;
+    }
+}
+
+void
+limboole_write (LimbooleManager * mgr, LimbooleNode * root, FILE * file)
+{
+  Writer writer;
+  Node **stack, *node;
+  unsigned size, count;
+  int first;
+
+  (void) mgr;
+
+  writer.file = file;
+  writer.count = 0;
+
+  size = 16;
+  stack = (Node **) malloc (size * sizeof (Node *));
+  stack[0] = root;
+  count = 1;
+  first = 1;
+
+  while (count)
+    {
+      node = stack[--count];
+      if (node->type == AND)
+	{
+	  if (count + 2 > size)
+	    {
+	      size *= 2;
+	      stack = (Node **) realloc (stack, size * sizeof (Node *));
+	    }
+	  stack[count++] = node->data.as_child[1];
+	  stack[count++] = node->data.as_child[0];
+	  continue;
+	}
+
+      if (!first)
+	write_str (&writer, "\n&\n");
+      first = 0;
+      write_aux (&writer, node, AND);
+    }
+  write_char (&writer, '\n');
+
+  write_flush (&writer);
+  free (stack);
+}
@@ -2,7 +2,33 @@
 #define __LIMBOOLE_H__
 
 #include <stdbool.h>
+#include <stdio.h> // Added on 16 October 2026
 
 int limboole(int argc, const char **argv, const bool *stopTrigger);
 
+// Added on 16 October 2026
+// An in-memory API: the formula is built node by node (no file and no parsing)
+// and the values of the variables are read directly from the SAT solver
+typedef struct Mgr LimbooleManager;
+typedef struct Node LimbooleNode;
+
+LimbooleManager *limboole_new(const bool *stopTrigger);
+void limboole_release(LimbooleManager *mgr);
+
+LimbooleNode *limboole_variable(LimbooleManager *mgr);
+LimbooleNode *limboole_not(LimbooleManager *mgr, LimbooleNode *child);
+LimbooleNode *limboole_and(LimbooleManager *mgr, LimbooleNode *c0, LimbooleNode *c1);
+LimbooleNode *limboole_or(LimbooleManager *mgr, LimbooleNode *c0, LimbooleNode *c1);
+LimbooleNode *limboole_implies(LimbooleManager *mgr, LimbooleNode *c0, LimbooleNode *c1);
+LimbooleNode *limboole_iff(LimbooleManager *mgr, LimbooleNode *c0, LimbooleNode *c1);
+
+// Checks the satisfiability of the formula. It can be called only once by manager
+// Returns 10 if satisfiable, 20 if unsatisfiable and 0 if stopped
+int limboole_sat(LimbooleManager *mgr, LimbooleNode *root);
+// After a satisfiable limboole_sat, returns 1 iff the variable is true
+int limboole_value(LimbooleManager *mgr, LimbooleNode *variable);
+// Writes the formula in the limboole syntax (the variables are named v followed by an integer)
+// The time is linear in the size of the output
+void limboole_write(LimbooleManager *mgr, LimbooleNode *root, FILE *file);
+
 #endif
\ No newline at end of file
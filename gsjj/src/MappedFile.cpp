@@ -0,0 +1,82 @@
+/**
+ * \file MappedFile.cpp
+ *
+ * This file implements the class MappedFile.
+ */
+
+#include "gsjj/MappedFile.h"
+
+#include <stdexcept>
+
+#if defined(_WIN32)
+#include <fstream>
+#include <iterator>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace gsjj {
+#if defined(_WIN32)
+    MappedFile::MappedFile(const std::string &filepath) :
+        m_data(nullptr),
+        m_size(0)
+    {
+        std::ifstream file(filepath, std::ios::binary);
+        if (!file) {
+            throw std::invalid_argument(filepath + " could not be open");
+        }
+        m_content.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+        m_size = m_content.size();
+        m_data = m_content.empty() ? nullptr : m_content.data();
+    }
+
+    MappedFile::~MappedFile() {
+    }
+#else
+    MappedFile::MappedFile(const std::string &filepath) :
+        m_data(nullptr),
+        m_size(0)
+    {
+        const int descriptor = open(filepath.c_str(), O_RDONLY);
+        if (descriptor == -1) {
+            throw std::invalid_argument(filepath + " could not be open");
+        }
+
+        struct stat status;
+        if (fstat(descriptor, &status) == -1) {
+            close(descriptor);
+            throw std::invalid_argument(filepath + " could not be open");
+        }
+        m_size = status.st_size;
+
+        // mmap does not accept a length of 0
+        if (m_size != 0) {
+            void *address = mmap(nullptr, m_size, PROT_READ, MAP_SHARED, descriptor, 0);
+            if (address == MAP_FAILED) {
+                close(descriptor);
+                throw std::invalid_argument(filepath + " could not be mapped in memory");
+            }
+            m_data = static_cast<const unsigned char*>(address);
+        }
+        // The mapping stays valid once the file is closed
+        close(descriptor);
+    }
+
+    MappedFile::~MappedFile() {
+        if (m_data) {
+            munmap(const_cast<unsigned char*>(m_data), m_size);
+        }
+    }
+#endif
+
+    const unsigned char *MappedFile::data() const {
+        return m_data;
+    }
+
+    std::size_t MappedFile::size() const {
+        return m_size;
+    }
+}
\ No newline at end of file
@@ -0,0 +1,233 @@
+/**
+ * \file MatcherGenerator.cpp
+ *
+ * This file implements the functions that generate C++ code matching the words accepted by a DFA.
+ *
+ * See MatcherGenerator.h
+ */
+
+#include "gsjj/MatcherGenerator.h"
+
+#include <algorithm>
+#include <cctype>
+#include <map>
+#include <sstream>
+#include <stdexcept>
+#include <vector>
+
+namespace gsjj {
+    namespace {
+        /**
+         * The reachable states, renumbered from 1 in BFS order (0 is the rejecting sink)
+         */
+        struct ReachableStates {
+            /**
+             * The state of the DFA of each number (states[0] is not used)
+             */
+            std::vector<unsigned int> states;
+            /**
+             * The number of each state of the DFA (0 if it is not reachable)
+             */
+            std::vector<unsigned int> number;
+        };
+
+        ReachableStates computeReachableStates(const DFA<char> &dfa) {
+            ReachableStates reachable;
+            reachable.number.assign(dfa.getTransitions().size(), 0);
+            reachable.states = {0, dfa.getInitialState()};
+            reachable.number[dfa.getInitialState()] = 1;
+            for (unsigned int i = 1 ; i < reachable.states.size() ; i++) {
+                for (const auto &transition : dfa.getTransitions(reachable.states[i])) {
+                    if (reachable.number[transition.second] == 0) {
+                        reachable.number[transition.second] = reachable.states.size();
+                        reachable.states.push_back(transition.second);
+                    }
+                }
+            }
+            return reachable;
+        }
+
+        /**
+         * Writes the symbol as a comment, if it can be printed
+         */
+        std::string symbolComment(char a) {
+            const unsigned char byte = static_cast<unsigned char>(a);
+            if (byte < 128 && std::isgraph(byte) && a != '\\') {
+                return std::string(" // ") + a;
+            }
+            return "";
+        }
+
+        void generateSwitch(std::ostringstream &code, const DFA<char> &dfa, const ReachableStates &reachable) {
+            code << "    inline bool isAccepted(const char *word, std::size_t length) {\n";
+            code << "        const char *const end = word + length;\n";
+            code << "        goto state1;\n";
+            for (unsigned int i = 1 ; i < reachable.states.size() ; i++) {
+                const unsigned int state = reachable.states[i];
+                code << "    state" << i << ":\n";
+                code << "        if (word == end) {\n";
+                code << "            return " << (dfa.isAcceptingState(state) ? "true" : "false") << ";\n";
+                code << "        }\n";
+                code << "        switch (static_cast<unsigned char>(*word++)) {\n";
+
+                // The symbols that go to the same state share their case
+                std::map<unsigned int, std::vector<char>> symbolsByTarget;
+                for (const auto &transition : dfa.getTransitions(state)) {
+                    symbolsByTarget[reachable.number[transition.second]].push_back(transition.first);
+                }
+                for (const auto &target : symbolsByTarget) {
+                    for (char a : target.second) {
+                        code << "        case " << static_cast<unsigned int>(static_cast<unsigned char>(a)) << ":" << symbolComment(a) << "\n";
+                    }
+                    code << "            goto state" << target.first << ";\n";
+                }
+                code << "        default:\n";
+                code << "            return false;\n";
+                code << "        }\n";
+            }
+            code << "    }\n";
+        }
+
+        void generateTable(std::ostringstream &code, const DFA<char> &dfa, const ReachableStates &reachable) {
+            std::map<char, unsigned int> columns;
+            for (unsigned int i = 1 ; i < reachable.states.size() ; i++) {
+                for (const auto &transition : dfa.getTransitions(reachable.states[i])) {
+                    columns.emplace(transition.first, 0);
+                }
+            }
+            std::vector<char> alphabet;
+            for (auto &column : columns) {
+                alphabet.push_back(column.first);
+                column.second = alphabet.size();
+            }
+
+            const unsigned int numberStates = reachable.states.size();
+            const unsigned int numberColumns = alphabet.size() + 1;
+            std::string entryType = "std::uint32_t";
+            if (numberStates <= (1u << 8)) {
+                entryType = "std::uint8_t";
+            }
+            else if (numberStates <= (1u << 16)) {
+                entryType = "std::uint16_t";
+            }
+
+            code << "    namespace detail {\n";
+            code << "        /**\n";
+            code << "         * Checks that the i-th symbol of the alphabet is in the column i + 1 and that the other bytes are in the column 0\n";
+            code << "         */\n";
+            code << "        constexpr bool checkColumns(const std::uint16_t *columns, const unsigned char *alphabet, std::size_t size) {\n";
+            code << "            for (unsigned int byte = 0 ; byte < 256 ; byte++) {\n";
+            code << "                unsigned int expected = 0;\n";
+            code << "                for (std::size_t i = 0 ; i < size ; i++) {\n";
+            code << "                    if (alphabet[i] == byte) {\n";
+            code << "                        expected = i + 1;\n";
+            code << "                    }\n";
+            code << "                }\n";
+            code << "                if (columns[byte] != expected) {\n";
+            code << "                    return false;\n";
+            code << "                }\n";
+            code << "            }\n";
+            code << "            return true;\n";
+            code << "        }\n";
+            code << "    }\n\n";
+
+            code << "    inline bool isAccepted(const char *word, std::size_t length) {\n";
+            // A zero-length array is not valid C++
+            code << "        static constexpr unsigned char alphabet[" << std::max<std::size_t>(alphabet.size(), 1) << "] = {";
+            for (std::size_t i = 0 ; i < alphabet.size() ; i++) {
+                code << (i == 0 ? "" : ", ") << static_cast<unsigned int>(static_cast<unsigned char>(alphabet[i]));
+            }
+            code << "};\n";
+
+            code << "        // The column of each byte\n";
+            code << "        static constexpr std::uint16_t columns[256] = {";
+            for (unsigned int byte = 0 ; byte < 256 ; byte++) {
+                auto itr = columns.find(static_cast<char>(byte));
+                code << (byte % 32 == 0 ? "\n            " : " ") << (itr == columns.end() ? 0 : itr->second) << ",";
+            }
+            code << "\n        };\n";
+            code << "        static_assert(detail::checkColumns(columns, alphabet, " << alphabet.size() << "), \"The columns of the table do not match the alphabet\");\n";
+
+            code << "        // The row of each state: the state 0 is a rejecting sink\n";
+            code << "        static constexpr " << entryType << " delta[" << numberStates << " * " << numberColumns << "] = {";
+            for (unsigned int i = 0 ; i < numberStates ; i++) {
+                std::vector<unsigned int> row(numberColumns, 0);
+                if (i != 0) {
+                    for (const auto &transition : dfa.getTransitions(reachable.states[i])) {
+                        row[columns[transition.first]] = reachable.number[transition.second];
+                    }
+                }
+                code << "\n           ";
+                for (unsigned int target : row) {
+                    code << " " << target << ",";
+                }
+            }
+            code << "\n        };\n";
+
+            code << "        static constexpr bool accepting[" << numberStates << "] = {";
+            for (unsigned int i = 0 ; i < numberStates ; i++) {
+                code << (i % 16 == 0 ? "\n            " : " ") << ((i != 0 && dfa.isAcceptingState(reachable.states[i])) ? "true" : "false") << ",";
+            }
+            code << "\n        };\n\n";
+
+            code << "        std::size_t state = 1;\n";
+            code << "        for (std::size_t i = 0 ; i < length ; i++) {\n";
+            code << "            state = delta[state * " << numberColumns << " + columns[static_cast<unsigned char>(word[i])]];\n";
+            code << "            if (state == 0) {\n";
+            code << "                return false;\n";
+            code << "            }\n";
+            code << "        }\n";
+            code << "        return accepting[state];\n";
+            code << "    }\n";
+        }
+    }
+
+    MatcherStyle matcherStyleFromName(const std::string &name) {
+        if (name == "switch") {
+            return MatcherStyle::Switch;
+        }
+        else if (name == "table") {
+            return MatcherStyle::Table;
+        }
+        else {
+            throw std::invalid_argument("Unknown matcher style: " + name);
+        }
+    }
+
+    std::string generateMatcher(const DFA<char> &dfa, const std::string &name, MatcherStyle style) {
+        bool validName = !name.empty() && !std::isdigit(static_cast<unsigned char>(name[0]));
+        for (char c : name) {
+            validName = validName && (std::isalnum(static_cast<unsigned char>(c)) || c == '_');
+        }
+        if (!validName) {
+            throw std::invalid_argument(name + " is not a valid C++ identifier");
+        }
+
+        const ReachableStates reachable = computeReachableStates(dfa);
+
+        std::ostringstream code;
+        code << "// Generated by libgsjj from a DFA with " << reachable.states.size() - 1 << " reachable states. Do not edit.\n";
+        code << "// This header only needs C++14.\n\n";
+        code << "#pragma once\n\n";
+        code << "#include <cstddef>\n";
+        code << "#include <cstdint>\n\n";
+        code << "namespace " << name << " {\n";
+
+        switch (style) {
+        case MatcherStyle::Switch:
+            generateSwitch(code, dfa, reachable);
+            break;
+        case MatcherStyle::Table:
+            generateTable(code, dfa, reachable);
+            break;
+        }
+
+        code << "\n";
+        code << "    template<typename Word>\n";
+        code << "    bool isAccepted(const Word &word) {\n";
+        code << "        return isAccepted(word.data(), word.size());\n";
+        code << "    }\n";
+        code << "}\n";
+        return code.str();
+    }
+}
\ No newline at end of file
@@ -8,6 +8,8 @@
 
 #include <iostream>
 #include <cmath>
+#include <list>
+#include <algorithm>
 
 #include "MapleCOMSPS_LRB/utils/System.h"
 
@@ -18,8 +20,8 @@ using namespace Minisat;
 namespace gsjj {
     namespace passive {
         namespace CNF {
-            BinaryCNFMethod::BinaryCNFMethod(const std::set<std::string> &SpSet, const std::set<std::string> &SmSet, const std::set<std::string> &SSet, const std::set<std::string> &prefixesSet, const std::set<char> &alphabetSet, unsigned int n) :
-                Method(SpSet, SmSet, SSet, prefixesSet, alphabetSet, n)
+            BinaryCNFMethod::BinaryCNFMethod(std::shared_ptr<const Sample> sample, unsigned int n) :
+                Method(sample, n)
             {
                 // Defaults values for the options (taken from the bcsat code)
                 m_simplify_opts.constant_folding = true;
@@ -47,9 +49,15 @@ namespace gsjj {
                     return m_hasSolution = (m_Sp.size() == 0 || m_Sm.size() == 0);
                 }
 
+                // The solver simplifies (and frees parts of) the circuit: the formula can not be added a second time
+                if (m_triedSolve) {
+                    return m_hasSolution;
+                }
+
                 // If needed, we create the solver
                 if (!m_solver) {
-                    std::atomic_bool falseBool(false);
+                    // The solver keeps a pointer to the trigger
+                    static std::atomic_bool falseBool(false);
                     m_solver = std::make_unique<BC>(falseBool);
                 }
 
@@ -95,170 +103,171 @@ namespace gsjj {
             }
 
             void BinaryCNFMethod::setStopTrigger(const std::chrono::seconds &timeLimit, std::atomic_bool &stopTrigger, const bool *stopPointer) {
-                m_solver = std::make_unique<BC>(stopTrigger);
+                // The gates of an already solved formula live in the current solver: it only changes its trigger
+                if (m_triedSolve && m_solver) {
+                    m_solver->setStopTrigger(stopTrigger);
+                }
+                else {
+                    m_solver = std::make_unique<BC>(stopTrigger);
+                }
             }
 
             void BinaryCNFMethod::createVariables() {
-                for (const auto &u : m_prefixes) {
+                // The memorised gates involve the previous variables
+                m_differentGates.clear();
+                m_equalGates.clear();
+
+                m_stateToVar.resize(m_prefixTree.size() * m_binarySize);
+                for (unsigned int u = 0 ; u < m_prefixTree.size() ; u++) {
                     for (unsigned int i = 0 ; i < m_binarySize ; i++) {
-                        Gate *var = m_solver->new_VAR();
-                        m_stateToVar.emplace(std::make_pair(u, i), var);
+                        m_stateToVar[u * m_binarySize + i] = m_solver->new_VAR();
                     }
                 }
             }
 
             Gate* BinaryCNFMethod::createFormula() {
-                Gate *formula = nullptr;
+                // The formula is the conjunction of every constraint. It's built at the end as a balanced tree
+                std::vector<Gate*> constraints;
 
                 // For every ua, va in prefixes such that the last letter of ua is the same as the last letter of va
-                for (const auto &ua : m_prefixes) {
-                    if (ua.size() > 0) {
-                        const char &a = ua.at(ua.size() - 1);
-                        const std::string &u = ua.substr(0, ua.size() - 1);
-
-                        for (const auto &va : m_prefixes) {
-                            if (va.size() > 0 && va.at(va.size() - 1) == a) {
-                                const std::string &v = va.substr(0, va.size() - 1);
-                                // We must force that x_u = x_v => x_{ua} = x_{va}
-                                // In other words, we force that the transition function is correct and coherent
-                                // So, we create a formula for NOT (x_u = x_v) OR x_ua = x_va
-                                Gate *different = phi_different(u, v);
-                                Gate *eq = equal(ua, va);
-                                Gate *full = m_solver->new_OR(different, eq);
-
-                                if (formula) {
-                                    formula = m_solver->new_AND(formula, full);
-                                }
-                                else {
-                                    formula = full;
-                                }
-                            }
+                // The formula is symmetric in u and v and always holds if u = v: we only need the pairs u < v (see computePrefixPairs)
+                for (const PrefixPair &pair : prefixPairs()) {
+                    const unsigned int u = pair.u;
+                    const unsigned int v = pair.v;
+
+                    // If u and v are in conflict, they can not end in the same state
+                    if (!pair.compatible) {
+                        constraints.push_back(phi_different(u, v));
+                        continue;
+                    }
+
+                    for (const unsigned int &ua : m_prefixTree[u].children) {
+                        const unsigned int va = m_prefixTree.getChild(v, m_prefixTree[ua].symbol);
+                        if (va == PrefixTree::none) {
+                            continue;
                         }
+                        // We must force that x_u = x_v => x_{ua} = x_{va}
+                        // In other words, we force that the transition function is correct and coherent
+                        // So, we create a formula for NOT (x_u = x_v) OR x_ua = x_va
+                        constraints.push_back(m_solver->new_OR(phi_different(u, v), equal(ua, va)));
                     }
                 }
 
                 // Now, we want to express that for every u in Sp and every v in Sm, x_u is different than x_v
                 // In other words, u and v can not end in the same state (since u must be accepted and v rejected)
-                for (const auto &u : m_Sp) {
-                    for (const auto &v : m_Sm) {
-                        formula = m_solver->new_AND(formula, phi_different(u, v));
+                for (const auto &u : m_SpIds) {
+                    for (const auto &v : m_SmIds) {
+                        constraints.push_back(phi_different(u, v));
                     }
                 }
 
                 // Finally, we must make sure that the encoding is correct even if the number of states is not a power of 2
                 // http://www.graphics.stanford.edu/~seander/bithacks.html#DetermineIfPowerOf2
-                for (const auto &u : m_prefixes) {
+                for (unsigned int u = 0 ; u < m_prefixTree.size() ; u++) {
                     for (unsigned int i = m_numberStates ; i < pow(2, m_binarySize) ; i++) {
-                        formula = m_solver->new_AND(formula, phi_not_q_i(u, i));
+                        constraints.push_back(phi_not_q_i(u, i));
                     }
                 }
 
-                return formula;
+                if (constraints.empty()) {
+                    return m_solver->new_TRUE();
+                }
+                return balanced(constraints, true);
             }
 
-            Gate* BinaryCNFMethod::equal(const std::string &u, const std::string &v) {
-                return m_solver->new_NOT(phi_different(u, v));
+            Gate* BinaryCNFMethod::equal(unsigned int u, unsigned int v) {
+                const auto key = std::make_pair(std::min(u, v), std::max(u, v));
+                auto itr = m_equalGates.find(key);
+                if (itr != m_equalGates.end()) {
+                    return itr->second;
+                }
+
+                Gate *gate = m_solver->new_NOT(phi_different(u, v));
+                m_equalGates.emplace(key, gate);
+                return gate;
             }
 
-            Gate* BinaryCNFMethod::phi_different(const std::string &u, const std::string &v) {
-                Gate *gate = nullptr;
+            Gate* BinaryCNFMethod::phi_different(unsigned int u, unsigned int v) {
+                const auto key = std::make_pair(std::min(u, v), std::max(u, v));
+                auto itr = m_differentGates.find(key);
+                if (itr != m_differentGates.end()) {
+                    return itr->second;
+                }
 
+                // At least one bit is different
+                std::vector<Gate*> bits(m_binarySize);
                 for (unsigned int j = 0 ; j < m_binarySize ; j++) {
-                    Gate *x_uj = m_stateToVar.find(std::make_pair(u, j))->second;
-                    Gate *x_vj = m_stateToVar.find(std::make_pair(v, j))->second;
+                    Gate *x_uj = m_stateToVar[u * m_binarySize + j];
+                    Gate *x_vj = m_stateToVar[v * m_binarySize + j];
                     Gate *left = m_solver->new_AND(x_uj, m_solver->new_NOT(x_vj));
                     Gate *right = m_solver->new_AND(m_solver->new_NOT(x_uj), x_vj);
-                    Gate *total = m_solver->new_OR(left, right);
-                    // If gate already exists, we just add an OR operation
-                    if (gate) {
-                        gate = m_solver->new_OR(gate, total);
-                    }
-                    else {
-                        gate = total;
-                    }
+                    bits[j] = m_solver->new_OR(left, right);
                 }
-                
+
+                Gate *gate = balanced(bits, false);
+                m_differentGates.emplace(key, gate);
                 return gate;
             }
 
-            Gate* BinaryCNFMethod::phi_not_q_i(const std::string &u, unsigned int i) {
-                Gate *gate = nullptr;
-
+            Gate* BinaryCNFMethod::phi_not_q_i(unsigned int u, unsigned int i) {
+                // Each (u, i) is only used once: there is nothing to memorise
                 std::vector<bool> bin_i = decimal_to_binary(i, m_binarySize);
 
+                std::vector<Gate*> literals(m_binarySize);
                 for (unsigned int j = 0 ; j < m_binarySize ; j++) {
-                    Gate *x_uj = m_stateToVar.find(std::make_pair(u, j))->second;
-                    Gate *l_uj = x_uj;
+                    Gate *x_uj = m_stateToVar[u * m_binarySize + j];
 
                     if (bin_i.at(j)) {
-                        l_uj = m_solver->new_NOT(x_uj);
-                    }
-
-                    if (gate) {
-                        gate = m_solver->new_OR(gate, l_uj);
+                        literals[j] = m_solver->new_NOT(x_uj);
                     }
                     else {
-                        gate = l_uj;
+                        literals[j] = x_uj;
                     }
                 }
 
-                return gate;
+                return balanced(literals, false);
+            }
+
+            Gate* BinaryCNFMethod::balanced(const std::vector<Gate*> &gates, bool conjunction) {
+                // The number of children of each gate of the tree
+                const std::size_t fanIn = 16;
+
+                std::vector<Gate*> level = gates;
+                while (level.size() > 1) {
+                    std::vector<Gate*> next;
+                    next.reserve(level.size() / fanIn + 1);
+                    for (std::size_t i = 0 ; i < level.size() ; i += fanIn) {
+                        const std::size_t end = std::min(level.size(), i + fanIn);
+                        if (end - i == 1) {
+                            next.push_back(level[i]);
+                        }
+                        else {
+                            std::list<Gate*> children(level.begin() + i, level.begin() + end);
+                            next.push_back(conjunction ? m_solver->new_AND(&children) : m_solver->new_OR(&children));
+                        }
+                    }
+                    level.swap(next);
+                }
+
+                return level[0];
             }
 
-            unsigned int BinaryCNFMethod::toState(const std::string &u) const {
+            unsigned int BinaryCNFMethod::toState(unsigned int u) const {
                 unsigned int state = 0;
                 for (int j = m_binarySize - 1 ; j >= 0 ; j--) {
-                    state += std::pow(2, j) * m_stateToVar.at(std::make_pair(u, j))->value;
+                    state += std::pow(2, j) * m_stateToVar[u * m_binarySize + j]->value;
                 }
                 return state;
             }
 
             std::unique_ptr<DFA<char>> BinaryCNFMethod::toDFA() const {
-                // First, we seek the initial state
-                unsigned int initial = toState("");
-
-                std::unique_ptr<DFA<char>> dfa = std::make_unique<DFA<char>>(initial, m_Sp.find("") != m_Sp.end());
-
-                // Now, we create the other states
-                for (unsigned int i = 0 ; i < m_numberStates ; i++) {
-                    if (i != initial) {
-                        bool accepting = false;
-
-                        // The state is accepting if there exists a word u in Sp that ends in the state u
-                        for (const auto &u : m_Sp) {
-                            if (i == toState(u)) {
-                                accepting = true;
-                                break;
-                            }
-                        }
-
-                        dfa->addState(i, accepting);
-                    }
+                // The state reached by each prefix
+                std::vector<unsigned int> states(m_prefixTree.size());
+                for (unsigned int u = 0 ; u < m_prefixTree.size() ; u++) {
+                    states[u] = toState(u);
                 }
 
-                // Finally, we create the transitions
-                for (unsigned int i = 0 ; i < m_numberStates ; i++) {
-                    for (const char &a : m_alphabet) {
-                        bool found = false;
-                        for (unsigned int j = 0 ; j < m_numberStates ; j++) {
-                            for (const auto &ua : m_prefixes) {
-                                if (ua.size() > 0 && ua.at(ua.size() - 1) == a){
-                                    std::string u = ua.substr(0, ua.size() - 1);
-
-                                    if (i == toState(u) && j == toState(ua)) {
-                                        found = true;
-                                        dfa->addTransition(i, a, j);
-                                    }
-                                }
-                            }
-                        }
-
-                        if (!found) {
-                            dfa->addTransition(i, a, i);
-                        }
-                    }
-                }
-                return dfa;
+                return dfaFromStates(states);
             }
         }
     }
@@ -0,0 +1,231 @@
+/**
+ * \file BinaryDirectCNFMethod.cpp
+ *
+ * This file implements the binary method directly encoded in CNF.
+ */
+
+#include "gsjj/passive/CNF/BinaryDirectCNFMethod.h"
+
+#include <algorithm>
+
+using namespace Minisat;
+
+namespace gsjj {
+    namespace passive {
+        namespace CNF {
+            BinaryDirectCNFMethod::BinaryDirectCNFMethod(std::shared_ptr<const Sample> sample, unsigned int n) :
+                SATCNFMethod(sample, n),
+                m_binarySize(0),
+                m_firstNewBit(0)
+            {
+                s_registered = s_registered;
+            }
+
+            BinaryDirectCNFMethod::~BinaryDirectCNFMethod() {
+
+            }
+
+            std::string BinaryDirectCNFMethod::getFactoryName() {
+                return "binaryDirect";
+            }
+
+            std::size_t BinaryDirectCNFMethod::equality(unsigned int u, unsigned int v) {
+                auto key = std::make_pair(std::min(u, v), std::max(u, v));
+                auto itr = m_pairIndex.find(key);
+                if (itr != m_pairIndex.end()) {
+                    return itr->second;
+                }
+
+                std::size_t index = m_equalities.size();
+                m_pairIndex.emplace(key, index);
+                m_pairs.push_back(key);
+                m_equalities.push_back({newVariable(), {}});
+                return index;
+            }
+
+            void BinaryDirectCNFMethod::createVariables(unsigned int firstNewState) {
+                const unsigned int numberPrefixes = m_prefixTree.size();
+
+                // The pairs do not depend on the number of states: they are all created the first time
+                if (firstNewState == 0) {
+                    m_binarySize = 0;
+                    m_bitVars = StateTable<Var>();
+                    m_pairs.clear();
+                    m_equalities.clear();
+                    m_pairIndex.clear();
+
+                    for (const PrefixPair &pair : prefixPairs()) {
+                        equality(pair.u, pair.v);
+                        if (pair.compatible) {
+                            for (const unsigned int &ua : m_prefixTree[pair.u].children) {
+                                const unsigned int va = m_prefixTree.getChild(pair.v, m_prefixTree[ua].symbol);
+                                if (va != PrefixTree::none) {
+                                    equality(ua, va);
+                                }
+                            }
+                        }
+                    }
+
+                    for (const auto &u : m_SpIds) {
+                        for (const auto &v : m_SmIds) {
+                            equality(u, v);
+                        }
+                    }
+                }
+
+                // m is the smallest integer such that 2^m >= n
+                unsigned int binarySize = 0;
+                while ((1u << binarySize) < m_numberStates) {
+                    binarySize++;
+                }
+                m_firstNewBit = m_binarySize;
+                m_binarySize = binarySize;
+
+                m_bitVars.resize(numberPrefixes, m_binarySize);
+                for (unsigned int u = 0 ; u < numberPrefixes ; u++) {
+                    for (unsigned int j = m_firstNewBit ; j < m_binarySize ; j++) {
+                        m_bitVars(u, j) = newVariable();
+                    }
+                }
+
+                for (Equality &eq : m_equalities) {
+                    for (unsigned int j = m_firstNewBit ; j < m_binarySize ; j++) {
+                        eq.bits.push_back(newVariable());
+                    }
+                }
+            }
+
+            void BinaryDirectCNFMethod::createClauses(unsigned int firstNewState) {
+                const unsigned int numberPrefixes = m_prefixTree.size();
+                vec<Lit> clause;
+
+                // The constraints on the pairs only involve the e_{u, v}: they are created once
+                if (firstNewState == 0) {
+                    vec<Lit> implication(2);
+                    for (const PrefixPair &pair : prefixPairs()) {
+                        const Var e_uv = m_equalities[equality(pair.u, pair.v)].equal;
+
+                        // If u and v are in conflict, they can not reach the same state
+                        if (!pair.compatible) {
+                            clause.clear();
+                            clause.push(mkLit(e_uv, true));
+                            addClause(clause);
+                            continue;
+                        }
+
+                        // e_{u, v} => e_{ua, va}
+                        for (const unsigned int &ua : m_prefixTree[pair.u].children) {
+                            const unsigned int va = m_prefixTree.getChild(pair.v, m_prefixTree[ua].symbol);
+                            if (va == PrefixTree::none) {
+                                continue;
+                            }
+                            implication[0] = mkLit(e_uv, true);
+                            implication[1] = mkLit(m_equalities[equality(ua, va)].equal, false);
+                            addClause(implication);
+                        }
+                    }
+
+                    // A word of Sp and a word of Sm can not reach the same state
+                    for (const auto &u : m_SpIds) {
+                        for (const auto &v : m_SmIds) {
+                            clause.clear();
+                            clause.push(mkLit(m_equalities[equality(u, v)].equal, true));
+                            addClause(clause);
+                        }
+                    }
+                }
+
+                // b_{u, v, j} <=> (x_{u, j} <=> x_{v, j}) and e_{u, v} => b_{u, v, j}, for the new bits
+                vec<Lit> ternary(3), binary(2);
+                for (std::size_t k = 0 ; k < m_equalities.size() ; k++) {
+                    const unsigned int u = m_pairs[k].first;
+                    const unsigned int v = m_pairs[k].second;
+                    const Equality &eq = m_equalities[k];
+                    for (unsigned int j = m_firstNewBit ; j < m_binarySize ; j++) {
+                        const Lit b = mkLit(eq.bits[j], false);
+                        const Lit x_u = mkLit(m_bitVars(u, j), false);
+                        const Lit x_v = mkLit(m_bitVars(v, j), false);
+
+                        ternary[0] = ~b; ternary[1] = ~x_u; ternary[2] = x_v;
+                        addClause(ternary);
+                        ternary[0] = ~b; ternary[1] = x_u; ternary[2] = ~x_v;
+                        addClause(ternary);
+                        ternary[0] = b; ternary[1] = x_u; ternary[2] = x_v;
+                        addClause(ternary);
+                        ternary[0] = b; ternary[1] = ~x_u; ternary[2] = ~x_v;
+                        addClause(ternary);
+
+                        binary[0] = mkLit(eq.equal, true);
+                        binary[1] = b;
+                        addClause(binary);
+                    }
+                }
+
+                // (AND_j b_{u, v, j}) => e_{u, v}
+                // It depends on every bit so it must be retracted when a new bit is added
+                for (const Equality &eq : m_equalities) {
+                    clause.clear();
+                    clause.push(mkLit(eq.equal, false));
+                    for (unsigned int j = 0 ; j < m_binarySize ; j++) {
+                        clause.push(mkLit(eq.bits[j], true));
+                    }
+                    addRetractableClause(clause);
+                }
+
+                // Every prefix reaches a state <= n - 1
+                // For every bit j of n - 1 that is 0: NOT x_{u, j} OR (OR_{k > j, bit k of n - 1 is 1} NOT x_{u, k})
+                const unsigned int last = m_numberStates - 1;
+                if ((1u << m_binarySize) > m_numberStates) {
+                    for (unsigned int u = 0 ; u < numberPrefixes ; u++) {
+                        for (unsigned int j = 0 ; j < m_binarySize ; j++) {
+                            if ((last >> j) & 1) {
+                                continue;
+                            }
+                            clause.clear();
+                            clause.push(mkLit(m_bitVars(u, j), true));
+                            for (unsigned int k = j + 1 ; k < m_binarySize ; k++) {
+                                if ((last >> k) & 1) {
+                                    clause.push(mkLit(m_bitVars(u, k), true));
+                                }
+                            }
+                            addRetractableClause(clause);
+                        }
+                    }
+                }
+
+                // The i-th prefix of the clique must reach the state i
+                // The bits of the new states and the new bits of the old states are fixed
+                for (unsigned int i = 0 ; i < m_numberStates && i < m_clique.size() ; i++) {
+                    const unsigned int u = m_prefixTree.find(m_clique[i]);
+                    for (unsigned int j = 0 ; j < m_binarySize ; j++) {
+                        if (i >= firstNewState || j >= m_firstNewBit) {
+                            clause.clear();
+                            clause.push(mkLit(m_bitVars(u, j), ((i >> j) & 1) == 0));
+                            addClause(clause);
+                        }
+                    }
+                }
+            }
+
+            unsigned int BinaryDirectCNFMethod::toState(unsigned int u, const vec<lbool> &model) const {
+                unsigned int state = 0;
+                for (unsigned int j = 0 ; j < m_binarySize ; j++) {
+                    if (model[m_bitVars(u, j)] == l_True) {
+                        state |= 1u << j;
+                    }
+                }
+                return state;
+            }
+
+            std::unique_ptr<DFA<char>> BinaryDirectCNFMethod::toDFA(const vec<lbool> &model) const {
+                // The state reached by each prefix
+                std::vector<unsigned int> states(m_prefixTree.size());
+                for (unsigned int u = 0 ; u < m_prefixTree.size() ; u++) {
+                    states[u] = toState(u, model);
+                }
+
+                return dfaFromStates(states);
+            }
+        }
+    }
+}
@@ -0,0 +1,170 @@
+/**
+ * \file HeuleVerwerBFSCNFMethod.cpp
+ *
+ * This file implements the Heule and Verwer method with the BFS-based symmetry breaking of Ulyantsev, Zakirzyanov and Shalyto.
+ */
+
+#include "gsjj/passive/CNF/HeuleVerwerBFSCNFMethod.h"
+
+using namespace Minisat;
+
+namespace gsjj {
+    namespace passive {
+        namespace CNF {
+            HeuleVerwerBFSCNFMethod::HeuleVerwerBFSCNFMethod(std::shared_ptr<const Sample> sample, unsigned int n) :
+                HeuleVerwerCNFMethod(sample, n)
+            {
+                // Both this class and HeuleVerwerCNFMethod inherit a s_registered
+                RegisterInFactory<HeuleVerwerBFSCNFMethod>::s_registered = RegisterInFactory<HeuleVerwerBFSCNFMethod>::s_registered;
+            }
+
+            HeuleVerwerBFSCNFMethod::~HeuleVerwerBFSCNFMethod() {
+            }
+
+            std::string HeuleVerwerBFSCNFMethod::getFactoryName() {
+                return "heuleBFS";
+            }
+
+            void HeuleVerwerBFSCNFMethod::createVariables(unsigned int firstNewState) {
+                HeuleVerwerCNFMethod::createVariables(firstNewState);
+                const unsigned int numberSymbols = m_symbols.size();
+
+                // Every variable involves two states i < j. Therefore, we only need to create the variables for the new j
+                m_tVars.resize(m_numberStates, m_numberStates);
+                m_pVars.resize(m_numberStates, m_numberStates);
+                m_mVars.resize(m_numberStates * numberSymbols, m_numberStates);
+                for (unsigned int j = firstNewState ; j < m_numberStates ; j++) {
+                    for (unsigned int i = 0 ; i < j ; i++) {
+                        m_tVars(i, j) = newVariable();
+                        m_pVars(j, i) = newVariable();
+                        for (unsigned int a = 0 ; a < numberSymbols ; a++) {
+                            m_mVars(i * numberSymbols + a, j) = newVariable();
+                        }
+                    }
+                }
+            }
+
+            void HeuleVerwerBFSCNFMethod::createSymmetryBreakingClauses(unsigned int firstNewState) {
+                const unsigned int numberSymbols = m_symbols.size();
+                vec<Lit> clause;
+
+                // The initial state is the root of the BFS tree
+                if (firstNewState == 0) {
+                    clause.push(mkLit(m_xVars(0, 0), false));
+                    addClause(clause);
+                }
+
+                for (unsigned int j = firstNewState ; j < m_numberStates ; j++) {
+                    for (unsigned int i = 0 ; i < j ; i++) {
+                        Var t_ij = m_tVars(i, j);
+                        Var p_ji = m_pVars(j, i);
+
+                        // t_{i, j} <=> OR_{a} d_{i, a, j}
+                        clause.clear();
+                        clause.push(mkLit(t_ij, true));
+                        for (unsigned int a = 0 ; a < numberSymbols ; a++) {
+                            Var d = m_dVars(i * numberSymbols + a, j);
+                            clause.push(mkLit(d, false));
+
+                            vec<Lit> implication(2);
+                            implication[0] = mkLit(d, true);
+                            implication[1] = mkLit(t_ij, false);
+                            addClause(implication);
+                        }
+                        addClause(clause);
+
+                        // p_{j, i} <=> t_{i, j} AND NOT t_{k, j} for every k < i
+                        // In other words, i is the smallest state with a transition to j
+                        clause.clear();
+                        clause.push(mkLit(p_ji, true));
+                        clause.push(mkLit(t_ij, false));
+                        addClause(clause);
+
+                        vec<Lit> definition;
+                        definition.push(mkLit(t_ij, true));
+                        for (unsigned int k = 0 ; k < i ; k++) {
+                            Var t_kj = m_tVars(k, j);
+                            clause.clear();
+                            clause.push(mkLit(p_ji, true));
+                            clause.push(mkLit(t_kj, true));
+                            addClause(clause);
+
+                            definition.push(mkLit(t_kj, false));
+                        }
+                        definition.push(mkLit(p_ji, false));
+                        addClause(definition);
+
+                        // m_{i, a, j} <=> d_{i, a, j} AND NOT d_{i, b, j} for every b < a
+                        // In other words, a is the smallest symbol from i to j
+                        for (unsigned int a = 0 ; a < numberSymbols ; a++) {
+                            Var m = m_mVars(i * numberSymbols + a, j);
+                            Var d_a = m_dVars(i * numberSymbols + a, j);
+
+                            clause.clear();
+                            clause.push(mkLit(m, true));
+                            clause.push(mkLit(d_a, false));
+                            addClause(clause);
+
+                            definition.clear();
+                            definition.push(mkLit(d_a, true));
+                            for (unsigned int b = 0 ; b < a ; b++) {
+                                Var d_b = m_dVars(i * numberSymbols + b, j);
+                                clause.clear();
+                                clause.push(mkLit(m, true));
+                                clause.push(mkLit(d_b, true));
+                                addClause(clause);
+
+                                definition.push(mkLit(d_b, false));
+                            }
+                            definition.push(mkLit(m, false));
+                            addClause(definition);
+                        }
+                    }
+
+                    // Every state (except the initial state) has a parent
+                    // Since every state must be reached, this clause stays true when new states are added
+                    if (j > 0) {
+                        clause.clear();
+                        for (unsigned int i = 0 ; i < j ; i++) {
+                            clause.push(mkLit(m_pVars(j, i), false));
+                        }
+                        addClause(clause);
+                    }
+                }
+
+                // The next clauses link j and j + 1. We need them as soon as j + 1 is new
+                unsigned int firstJ = (firstNewState == 0) ? 0 : firstNewState - 1;
+                for (unsigned int j = firstJ ; j + 1 < m_numberStates ; j++) {
+                    // The parents are in BFS order: p_{j, i} => NOT p_{j + 1, k} for every k < i
+                    for (unsigned int i = 0 ; i < j ; i++) {
+                        Var p_ji = m_pVars(j, i);
+                        for (unsigned int k = 0 ; k < i ; k++) {
+                            clause.clear();
+                            clause.push(mkLit(p_ji, true));
+                            clause.push(mkLit(m_pVars(j + 1, k), true));
+                            addClause(clause);
+                        }
+                    }
+
+                    // Two consecutive children of the same parent are ordered by their smallest symbol:
+                    // p_{j, i} AND p_{j + 1, i} AND m_{i, a, j} => NOT m_{i, b, j + 1} for every b < a
+                    for (unsigned int i = 0 ; i < j ; i++) {
+                        Var p_ji = m_pVars(j, i);
+                        Var p_j1i = m_pVars(j + 1, i);
+                        for (unsigned int a = 0 ; a < numberSymbols ; a++) {
+                            Var m_iaj = m_mVars(i * numberSymbols + a, j);
+                            for (unsigned int b = 0 ; b < a ; b++) {
+                                clause.clear();
+                                clause.push(mkLit(p_ji, true));
+                                clause.push(mkLit(p_j1i, true));
+                                clause.push(mkLit(m_iaj, true));
+                                clause.push(mkLit(m_mVars(i * numberSymbols + b, j + 1), true));
+                                addClause(clause);
+                            }
+                        }
+                    }
+                }
+            }
+        }
+    }
+}
@@ -13,8 +13,8 @@ using namespace Minisat;
 namespace gsjj {
     namespace passive {
         namespace CNF {
-            HeuleVerwerCNFMethod::HeuleVerwerCNFMethod(const std::set<std::string> &SpSet, const std::set<std::string> &SmSet, const std::set<std::string> &SSet, const std::set<std::string> &prefixesSet, const std::set<char> &alphabetSet, unsigned int n) :
-                SATCNFMethod(SpSet, SmSet, SSet, prefixesSet, alphabetSet, n)
+            HeuleVerwerCNFMethod::HeuleVerwerCNFMethod(std::shared_ptr<const Sample> sample, unsigned int n) :
+                SATCNFMethod(sample, n)
             {
                 s_registered = s_registered;
             }
@@ -26,49 +26,55 @@ namespace gsjj {
                 return "heule";
             }
 
-            void HeuleVerwerCNFMethod::createVariables() {
+            void HeuleVerwerCNFMethod::createVariables(unsigned int firstNewState) {
+                // Only the variables involving a new state are created (every variable the first time)
+                const unsigned int numberSymbols = m_symbols.size();
+
                 // The x variables (same as for Grinchtein, Leucker and Piterman's unary method)
-                for (const auto &u : m_prefixes) {
-                    for (unsigned int q = 0; q < m_numberStates; q++) {
-                        auto pair = std::make_pair(u, q);
-                        Var var = newVariable();
-                        m_xVars.emplace(pair, var);
+                m_xVars.resize(m_prefixTree.size(), m_numberStates);
+                for (unsigned int u = 0 ; u < m_prefixTree.size() ; u++) {
+                    for (unsigned int q = firstNewState; q < m_numberStates; q++) {
+                        m_xVars(u, q) = newVariable();
                     }
                 }
 
                 // The d variables : for each state, for each symbol, for each state, there is a distinct variable
+                m_dVars.resize(m_numberStates * numberSymbols, m_numberStates);
                 for (unsigned int p = 0; p < m_numberStates; p++) {
-                    for (const char &a : m_alphabet) {
+                    for (unsigned int a = 0 ; a < numberSymbols ; a++) {
                         for (unsigned int q = 0; q < m_numberStates; q++) {
-                            auto trip = std::make_tuple(p, a, q);
-                            Var var = newVariable();
-                            m_dVars.emplace(trip, var);
+                            if (p < firstNewState && q < firstNewState) {
+                                continue;
+                            }
+                            m_dVars(p * numberSymbols + a, q) = newVariable();
                         }
                     }
                 }
 
                 // The f variables : for each state, there is a distinct variable
-                for (unsigned int q = 0; q < m_numberStates; q++) {
-                    m_fVars.emplace(q, newVariable());
+                for (unsigned int q = firstNewState; q < m_numberStates; q++) {
+                    m_fVars.push_back(newVariable());
                 }
             }
 
-            void HeuleVerwerCNFMethod::createClauses() {
+            void HeuleVerwerCNFMethod::createClauses(unsigned int firstNewState) {
+                // Only the clauses involving a new state are created (every clause the first time)
+                // Equations 4.5.2 and 4.5.5 depend on the whole set of states and are therefore retractable
+                const unsigned int numberPrefixes = m_prefixTree.size();
+                const unsigned int numberSymbols = m_symbols.size();
+
                 // Equation 4.5.1
                 // For every p in Q, a in Sigma, q, q' in Q such that q != q', we must have NOT (d_{p, a, q} AND d_{p, a, q'})
                 // In other words, d must encode a deterministic transition function
-                vec<Lit> clause(2);
+                // The groups of the d variables come after the groups of the x variables (see Equation 4.5.6)
+                vec<Lit> clause;
+                vec<Lit> group(m_numberStates);
                 for (unsigned int p = 0; p < m_numberStates; p++) {
-                    for (const char &a : m_alphabet) {
+                    for (unsigned int a = 0 ; a < numberSymbols ; a++) {
                         for (unsigned int q = 0; q < m_numberStates; q++) {
-                            for (unsigned int r = 0; r < m_numberStates; r++) {
-                                if (q != r) {
-                                    clause[0] = mkLit(m_dVars.find(std::make_tuple(p, a, q))->second, true);
-                                    clause[1] = mkLit(m_dVars.find(std::make_tuple(p, a, r))->second, true);
-                                    addClause(clause);
-                                }
-                            }
+                            group[q] = mkLit(m_dVars(p * numberSymbols + a, q), false);
                         }
+                        addAtMostOne(numberPrefixes + p * numberSymbols + a, group, (p >= firstNewState) ? 0 : firstNewState);
                     }
                 }
 
@@ -77,11 +83,11 @@ namespace gsjj {
                 // In other words, every prefix must reach at least one state
                 clause.clear();
                 clause.growTo(m_numberStates);
-                for (const auto &u : m_prefixes) {
+                for (unsigned int u = 0 ; u < numberPrefixes ; u++) {
                     for (unsigned int q = 0 ; q < m_numberStates ; q++) {
-                        clause[q] = mkLit(m_xVars.find(std::make_pair(u, q))->second, false);
+                        clause[q] = mkLit(m_xVars(u, q), false);
                     }
-                    addClause(clause);
+                    addRetractableClause(clause);
                 }
 
                 // Equation 4.5.3
@@ -89,18 +95,20 @@ namespace gsjj {
                 // In other words, if delta(q_0, u) = p and delta(p, a) = q, we must have delta(q_0, ua) = q
                 clause.clear();
                 clause.growTo(3);
-                for (const auto &ua : m_prefixes) {
-                    if (ua.size() > 0) {
-                        const std::string &u = ua.substr(0, ua.size() - 1);
-                        const char &a = ua.at(ua.size() - 1);
-
-                        for (unsigned int p = 0 ; p < m_numberStates ; p++) {
-                            for (unsigned int q = 0 ; q < m_numberStates ; q++) {
-                                clause[0] = mkLit(m_xVars.find(std::make_pair(u, p))->second, true);
-                                clause[1] = mkLit(m_dVars.find(std::make_tuple(p, a, q))->second, true);
-                                clause[2] = mkLit(m_xVars.find(std::make_pair(ua, q))->second, false);
-                                addClause(clause);
+                // The root (the empty word) is the only prefix without a last symbol
+                for (unsigned int ua = 1 ; ua < numberPrefixes ; ua++) {
+                    const unsigned int u = m_prefixTree[ua].parent;
+                    const unsigned int a = symbolIndex(m_prefixTree[ua].symbol);
+
+                    for (unsigned int p = 0 ; p < m_numberStates ; p++) {
+                        for (unsigned int q = 0 ; q < m_numberStates ; q++) {
+                            if (p < firstNewState && q < firstNewState) {
+                                continue;
                             }
+                            clause[0] = mkLit(m_xVars(u, p), true);
+                            clause[1] = mkLit(m_dVars(p * numberSymbols + a, q), true);
+                            clause[2] = mkLit(m_xVars(ua, q), false);
+                            addClause(clause);
                         }
                     }
                 }
@@ -112,16 +120,16 @@ namespace gsjj {
                 // In other words, the DFA must be consistent with S
                 clause.clear();
                 clause.growTo(2);
-                for (unsigned int q = 0; q < m_numberStates; q++) {
-                    for (const auto &u : m_Sp) {
-                        clause[0] = mkLit(m_xVars.find(std::make_pair(u, q))->second, true);
-                        clause[1] = mkLit(m_fVars.find(q)->second, false);
+                for (unsigned int q = firstNewState; q < m_numberStates; q++) {
+                    for (const auto &u : m_SpIds) {
+                        clause[0] = mkLit(m_xVars(u, q), true);
+                        clause[1] = mkLit(m_fVars[q], false);
                         addClause(clause);
                     }
 
-                    for (const auto &u : m_Sm) {
-                        clause[0] = mkLit(m_xVars.find(std::make_pair(u, q))->second, true);
-                        clause[1] = mkLit(m_fVars.find(q)->second, true);
+                    for (const auto &u : m_SmIds) {
+                        clause[0] = mkLit(m_xVars(u, q), true);
+                        clause[1] = mkLit(m_fVars[q], true);
                         addClause(clause);
                     }
                 }
@@ -132,11 +140,11 @@ namespace gsjj {
                 clause.clear();
                 clause.growTo(m_numberStates);
                 for (unsigned int p = 0; p < m_numberStates; p++) {
-                    for (const char &a : m_alphabet) {
+                    for (unsigned int a = 0 ; a < numberSymbols ; a++) {
                         for (unsigned int q = 0; q < m_numberStates; q++) {
-                            clause[q] = mkLit(m_dVars.find(std::make_tuple(p, a, q))->second, false);
+                            clause[q] = mkLit(m_dVars(p * numberSymbols + a, q), false);
                         }
-                        addClause(clause);
+                        addRetractableClause(clause);
                     }
                 }
 
@@ -144,18 +152,11 @@ namespace gsjj {
                 // For every u in Pref, p, q in Q such that p != q, me must have NOT (x_{u, p} AND x_{u, q})
                 // This equation forces that at most one variable in x_{u, q_0}, ..., x_{u, q_n} is true
                 // Therefore, along with 4.5.2, we now have that every prefix ends in exactly one state
-                clause.clear();
-                clause.growTo(2);
-                for (const auto &u : m_prefixes) {
-                    for (unsigned int p = 0 ; p < m_numberStates ; p++) {
-                        for (unsigned int q = 0 ; q < m_numberStates ; q++) {
-                            if (p != q) {
-                                clause[0] = mkLit(m_xVars.find(std::make_pair(u, p))->second, true);
-                                clause[1] = mkLit(m_xVars.find(std::make_pair(u, q))->second, true);
-                                addClause(clause);
-                            }
-                        }
+                for (unsigned int u = 0 ; u < numberPrefixes ; u++) {
+                    for (unsigned int q = 0 ; q < m_numberStates ; q++) {
+                        group[q] = mkLit(m_xVars(u, q), false);
                     }
+                    addAtMostOne(u, group, firstNewState);
                 }
 
                 // Equation 4.5.7
@@ -163,50 +164,63 @@ namespace gsjj {
                 // If we have delta(q_0, u) = p and delta(q_0, ua) = q, then we must have that delta(p, a) = q to remain coherent
                 clause.clear();
                 clause.growTo(3);
-                for (const auto &ua : m_prefixes) {
-                    if (ua.size() > 0) {
-                        const std::string &u = ua.substr(0, ua.size() - 1);
-                        const char &a = ua.at(ua.size() - 1);
-
-                        for (unsigned int p = 0 ; p < m_numberStates ; p++) {
-                            for (unsigned int q = 0 ; q < m_numberStates ; q++) {
-                                clause[0] = mkLit(m_xVars.find(std::make_pair(u, p))->second, true);
-                                clause[1] = mkLit(m_xVars.find(std::make_pair(ua, q))->second, true);
-                                clause[2] = mkLit(m_dVars.find(std::make_tuple(p, a, q))->second, false);
-                                addClause(clause);
+                for (unsigned int ua = 1 ; ua < numberPrefixes ; ua++) {
+                    const unsigned int u = m_prefixTree[ua].parent;
+                    const unsigned int a = symbolIndex(m_prefixTree[ua].symbol);
+
+                    for (unsigned int p = 0 ; p < m_numberStates ; p++) {
+                        for (unsigned int q = 0 ; q < m_numberStates ; q++) {
+                            if (p < firstNewState && q < firstNewState) {
+                                continue;
                             }
+                            clause[0] = mkLit(m_xVars(u, p), true);
+                            clause[1] = mkLit(m_xVars(ua, q), true);
+                            clause[2] = mkLit(m_dVars(p * numberSymbols + a, q), false);
+                            addClause(clause);
                         }
                     }
                 }
+
+                createSymmetryBreakingClauses(firstNewState);
+            }
+
+            void HeuleVerwerCNFMethod::createSymmetryBreakingClauses(unsigned int firstNewState) {
+                // The i-th prefix of the clique must reach the state i
+                vec<Lit> clause(1);
+                for (unsigned int i = firstNewState ; i < m_numberStates && i < m_clique.size() ; i++) {
+                    clause[0] = mkLit(m_xVars(m_prefixTree.find(m_clique[i]), i), false);
+                    addClause(clause);
+                }
             }
 
             std::unique_ptr<DFA<char>> HeuleVerwerCNFMethod::toDFA(const Minisat::vec<Minisat::lbool> &model) const {
-                // First, we must seek the initial state
+                const unsigned int numberSymbols = m_symbols.size();
+
+                // First, we must seek the initial state (the empty word is the root of the tree)
                 unsigned int initial = 0;
                 for (unsigned int i = 0; i < m_numberStates; i++) {
-                    Var v = m_xVars.find(std::make_pair("", i))->second;
-                    if (model[v] == l_True) {
+                    if (model[m_xVars(0, i)] == l_True) {
                         initial = i;
                         break;
                     }
                 }
 
                 // The initial state is accepting if f_{initial} is true
-                std::unique_ptr<DFA<char>> dfa = std::make_unique<DFA<char>>(initial, model[m_fVars.find(initial)->second] == l_True);
+                std::unique_ptr<DFA<char>> dfa = std::make_unique<DFA<char>>(initial, model[m_fVars[initial]] == l_True, m_numberStates, numberSymbols);
 
                 // Now, we create every other state (and define the accepting ones)
                 for (unsigned int q = 0; q < m_numberStates; q++) {
                     if (q != initial) {
-                        dfa->addState(q, model[m_fVars.find(q)->second] == l_True);
+                        dfa->addState(q, model[m_fVars[q]] == l_True);
                     }
                 }
 
                 // Finally, we create the transitions
                 for (unsigned int p = 0; p < m_numberStates; p++) {
-                    for (const char &a : m_alphabet) {
+                    for (unsigned int a = 0 ; a < numberSymbols ; a++) {
                         for (unsigned int q = 0; q < m_numberStates; q++) {
-                            if (model[m_dVars.find(std::make_tuple(p, a, q))->second] == l_True) {
-                                dfa->addTransition(p, a, q);
+                            if (model[m_dVars(p * numberSymbols + a, q)] == l_True) {
+                                dfa->addTransition(p, m_symbols[a], q);
                             }
                         }
                     }
@@ -1,6 +1,8 @@
 #include "gsjj/passive/CNF/SATCNFMethod.h"
 
 #include <iostream>
+#include <cmath>
+#include <stdexcept>
 
 #include "MapleCOMSPS_LRB/utils/System.h"
 
@@ -9,9 +11,33 @@ using namespace Minisat;
 namespace gsjj {
     namespace passive {
         namespace CNF {
-            SATCNFMethod::SATCNFMethod(const std::set<std::string> &SpSet, const std::set<std::string> &SmSet, const std::set<std::string> &SSet, const std::set<std::string> &prefixesSet, const std::set<char> &alphabetSet, unsigned int n) :
-                Method(SpSet, SmSet, SSet, prefixesSet, alphabetSet, n),
-                mustStop(nullptr)
+            AtMostOneEncoding atMostOneEncodingFromName(const std::string &name) {
+                if (name == "pairwise") {
+                    return AtMostOneEncoding::Pairwise;
+                }
+                else if (name == "sequential") {
+                    return AtMostOneEncoding::Sequential;
+                }
+                else if (name == "commander") {
+                    return AtMostOneEncoding::Commander;
+                }
+                else if (name == "product") {
+                    return AtMostOneEncoding::Product;
+                }
+                else {
+                    throw std::invalid_argument("Unknown at-most-one encoding: " + name);
+                }
+            }
+
+            AtMostOneEncoding SATCNFMethod::s_defaultAtMostOneEncoding = AtMostOneEncoding::Pairwise;
+
+            SATCNFMethod::SATCNFMethod(std::shared_ptr<const Sample> sample, unsigned int n) :
+                Method(sample, n),
+                m_atMostOneEncoding(s_defaultAtMostOneEncoding),
+                mustStop(nullptr),
+                m_neverStop(false),
+                m_incremental(false),
+                m_activation(lit_Undef)
             {
             }
 
@@ -20,24 +46,35 @@ namespace gsjj {
             }
 
             bool SATCNFMethod::solve() {
-                if (mustStop) {
-                    m_solver = std::make_unique<SimpSolver>(*mustStop);
-                }
-                else {
-                    std::atomic_bool falseBool(false);
-                    m_solver = std::make_unique<SimpSolver>(falseBool);
+                // In incremental mode, the solver (and everything it learnt) is kept between the calls
+                if (!m_incremental || !m_solver) {
+                    m_solver = std::make_unique<SimpSolver>(mustStop ? *mustStop : m_neverStop);
+                    m_solver->verbosity = 0;
+                    // The ladders belonged to the previous solver
+                    m_ladders.clear();
+                    if (m_incremental) {
+                        m_activation = mkLit(newVariable(), false);
+                    }
+                    createVariables(0);
+                    createClauses(0);
+                    // Maple crashes on a problem without any variable (for instance, one state and nothing to compare)
+                    if (m_solver->nVars() == 0) {
+                        newVariable();
+                    }
                 }
-                m_solver->verbosity = 0;
-                createVariables();
-                createClauses();
 
                 m_triedSolve = true;
                 // If mustStop is a valid pointer and if the value is true
                 if (mustStop && *mustStop) {
                     return false;
                 }
+                m_assumptions.clear();
+                if (m_incremental) {
+                    m_assumptions.push(m_activation);
+                }
                 m_cpuTimeStart = cpuTime();
-                m_hasSolution = m_solver->solve(true, false);
+                // The simplifications would not survive the clauses added for the next states
+                m_hasSolution = m_solver->solve(m_assumptions, !m_incremental, false);
                 m_cpuTimeEnd = cpuTime();
                 return m_hasSolution;
             }
@@ -61,6 +98,43 @@ namespace gsjj {
 
             void SATCNFMethod::setStopTrigger(const std::chrono::seconds &timeLimit, std::atomic_bool &stopTrigger, const bool *stopPointer) {
                 mustStop = &stopTrigger;
+                // In incremental mode, the solver may outlive the previous trigger
+                if (m_solver) {
+                    m_solver->setStopTrigger(stopTrigger);
+                }
+            }
+
+            bool SATCNFMethod::enableIncrementalMode() {
+                // The encoding of the first solve() would not allow to add new states
+                if (m_triedSolve) {
+                    return false;
+                }
+                m_incremental = true;
+                return true;
+            }
+
+            bool SATCNFMethod::incrementNumberOfStates() {
+                if (!m_incremental) {
+                    return false;
+                }
+
+                unsigned int firstNewState = m_numberStates;
+                m_numberStates++;
+                m_triedSolve = false;
+                m_hasSolution = false;
+
+                // Nothing has been encoded yet: solve() will encode everything at once
+                if (!m_solver) {
+                    return true;
+                }
+
+                // The clauses for the previous number of states are permanently disabled...
+                m_solver->addClause(~m_activation);
+                // ... and the new ones will be guarded by a fresh literal
+                m_activation = mkLit(newVariable(), false);
+                createVariables(firstNewState);
+                createClauses(firstNewState);
+                return true;
             }
 
             Minisat::Var SATCNFMethod::newVariable() {
@@ -70,6 +144,142 @@ namespace gsjj {
             void SATCNFMethod::addClause(const Minisat::vec<Minisat::Lit> &clause) {
                 m_solver->addClause(clause);
             }
+
+            void SATCNFMethod::addRetractableClause(const Minisat::vec<Minisat::Lit> &clause) {
+                if (m_incremental) {
+                    clause.copyTo(m_guardedClause);
+                    m_guardedClause.push(~m_activation);
+                    m_solver->addClause(m_guardedClause);
+                }
+                else {
+                    m_solver->addClause(clause);
+                }
+            }
+
+            void SATCNFMethod::setAtMostOneEncoding(AtMostOneEncoding encoding) {
+                m_atMostOneEncoding = encoding;
+            }
+
+            void SATCNFMethod::setDefaultAtMostOneEncoding(AtMostOneEncoding encoding) {
+                s_defaultAtMostOneEncoding = encoding;
+            }
+
+            void SATCNFMethod::addAtMostOne(std::size_t group, const Minisat::vec<Minisat::Lit> &literals, unsigned int firstNew) {
+                switch (m_atMostOneEncoding) {
+                case AtMostOneEncoding::Pairwise:
+                    addAtMostOnePairwise(literals, firstNew, false);
+                    break;
+                case AtMostOneEncoding::Sequential: {
+                    if (m_ladders.size() <= group) {
+                        m_ladders.resize(group + 1);
+                    }
+                    std::vector<Var> &ladder = m_ladders[group];
+                    ladder.resize(firstNew);
+                    // The last variable of the ladder is not needed for the current literals but it allows to add new ones
+                    vec<Lit> clause(2);
+                    for (int i = firstNew ; i < literals.size() ; i++) {
+                        ladder.push_back(newVariable());
+                        // x_i => s_i
+                        clause[0] = ~literals[i];
+                        clause[1] = mkLit(ladder[i], false);
+                        addClause(clause);
+                        if (i > 0) {
+                            // s_{i - 1} => s_i
+                            clause[0] = mkLit(ladder[i - 1], true);
+                            clause[1] = mkLit(ladder[i], false);
+                            addClause(clause);
+                            // s_{i - 1} => NOT x_i
+                            clause[0] = mkLit(ladder[i - 1], true);
+                            clause[1] = ~literals[i];
+                            addClause(clause);
+                        }
+                    }
+                    break;
+                }
+                case AtMostOneEncoding::Commander:
+                    addAtMostOneCommander(literals);
+                    break;
+                case AtMostOneEncoding::Product:
+                    addAtMostOneProduct(literals);
+                    break;
+                }
+            }
+
+            void SATCNFMethod::addAtMostOnePairwise(const Minisat::vec<Minisat::Lit> &literals, unsigned int firstNew, bool retractable) {
+                vec<Lit> clause(2);
+                // Each pair i < j once, with j new
+                for (int j = firstNew ; j < literals.size() ; j++) {
+                    for (int i = 0 ; i < j ; i++) {
+                        clause[0] = ~literals[i];
+                        clause[1] = ~literals[j];
+                        if (retractable) {
+                            addRetractableClause(clause);
+                        }
+                        else {
+                            addClause(clause);
+                        }
+                    }
+                }
+            }
+
+            void SATCNFMethod::addAtMostOneCommander(const Minisat::vec<Minisat::Lit> &literals) {
+                // Below this size, the pairwise encoding is smaller
+                if (literals.size() <= 6) {
+                    addAtMostOnePairwise(literals, 0, true);
+                    return;
+                }
+
+                // Each commander is implied by the literals of its group, which contains at most one true literal
+                vec<Lit> commanders, group, clause(2);
+                for (int start = 0 ; start < literals.size() ; start += 3) {
+                    group.clear();
+                    for (int i = start ; i < literals.size() && i < start + 3 ; i++) {
+                        group.push(literals[i]);
+                    }
+                    addAtMostOnePairwise(group, 0, true);
+
+                    Lit commander = mkLit(newVariable(), false);
+                    for (int i = 0 ; i < group.size() ; i++) {
+                        clause[0] = ~group[i];
+                        clause[1] = commander;
+                        addRetractableClause(clause);
+                    }
+                    commanders.push(commander);
+                }
+
+                // At most one group can contain a true literal
+                addAtMostOneCommander(commanders);
+            }
+
+            void SATCNFMethod::addAtMostOneProduct(const Minisat::vec<Minisat::Lit> &literals) {
+                // Below this size, the pairwise encoding is smaller
+                if (literals.size() <= 6) {
+                    addAtMostOnePairwise(literals, 0, true);
+                    return;
+                }
+
+                // The literals are placed in a grid. Two different literals are in different rows or in different columns
+                const int numberRows = std::ceil(std::sqrt(literals.size()));
+                const int numberColumns = (literals.size() + numberRows - 1) / numberRows;
+                vec<Lit> rows, columns, clause(2);
+                for (int r = 0 ; r < numberRows ; r++) {
+                    rows.push(mkLit(newVariable(), false));
+                }
+                for (int c = 0 ; c < numberColumns ; c++) {
+                    columns.push(mkLit(newVariable(), false));
+                }
+
+                for (int i = 0 ; i < literals.size() ; i++) {
+                    clause[0] = ~literals[i];
+                    clause[1] = rows[i / numberColumns];
+                    addRetractableClause(clause);
+                    clause[1] = columns[i % numberColumns];
+                    addRetractableClause(clause);
+                }
+
+                addAtMostOneProduct(rows);
+                addAtMostOneProduct(columns);
+            }
         }
     }
 }
\ No newline at end of file
@@ -7,8 +7,8 @@ using namespace Minisat;
 namespace gsjj {
     namespace passive {
         namespace CNF {
-            UnaryCNFMethod::UnaryCNFMethod(const std::set<std::string> &SpSet, const std::set<std::string> &SmSet, const std::set<std::string> &SSet, const std::set<std::string> &prefixesSet, const std::set<char> &alphabetSet, unsigned int n) :
-                SATCNFMethod(SpSet, SmSet, SSet, prefixesSet, alphabetSet, n)
+            UnaryCNFMethod::UnaryCNFMethod(std::shared_ptr<const Sample> sample, unsigned int n) :
+                SATCNFMethod(sample, n)
             {
                 s_registered = s_registered;
             }
@@ -21,76 +21,86 @@ namespace gsjj {
                 return "unary";
             }
 
-            void UnaryCNFMethod::createVariables() {
-                // For each prefix and each state in the DFA, we create a new variable
-                for (const auto &u : m_prefixes) {
-                    for (unsigned int q = 0 ; q < m_numberStates ; q++) {
-                        auto pair = std::make_pair(u, q);
-                        Var var = newVariable();
-                        m_stateName.insert(state(pair, var));
+            void UnaryCNFMethod::createVariables(unsigned int firstNewState) {
+                // For each prefix and each (new) state in the DFA, we create a new variable
+                m_stateName.resize(m_prefixTree.size(), m_numberStates);
+                for (unsigned int u = 0 ; u < m_prefixTree.size() ; u++) {
+                    for (unsigned int q = firstNewState ; q < m_numberStates ; q++) {
+                        m_stateName(u, q) = newVariable();
                     }
                 }
             }
 
-            void UnaryCNFMethod::createClauses() {
+            void UnaryCNFMethod::createClauses(unsigned int firstNewState) {
+                const unsigned int numberPrefixes = m_prefixTree.size();
+
                 // Equation 4.3.1
+                // It depends on every state so it must be retracted when a new state is added
                 // For some reason, Minisat defines its own vector type...
                 vec<Lit> clause(m_numberStates);
-                for (const auto &u : m_prefixes) {
+                for (unsigned int u = 0 ; u < numberPrefixes ; u++) {
                     for (unsigned int q = 0 ; q < m_numberStates ; q++) {
-                        // We know (u, q) is in the map thanks to createVariables
-                        clause[q] = mkLit(m_stateName.find(std::make_pair(u, q))->second, false);
+                        clause[q] = mkLit(m_stateName(u, q), false);
                     }
-                    addClause(clause);
+                    addRetractableClause(clause);
                 }
 
                 // Equation 4.3.2
-                clause.clear();
-                clause.growTo(2);
-                for (const auto &u : m_prefixes) {
+                // Every prefix reaches at most one state
+                for (unsigned int u = 0 ; u < numberPrefixes ; u++) {
                     for (unsigned int q = 0 ; q < m_numberStates ; q++) {
-                        for (unsigned int p = 0 ; p < m_numberStates ; p++) {
-                            if (p != q) {
-                                Var qState = m_stateName.find(std::make_pair(u, q))->second;
-                                Var pState = m_stateName.find(std::make_pair(u, p))->second;
-                                clause[0] = mkLit(qState, true);
-                                clause[1] = mkLit(pState, true);
-                                addClause(clause);
-                            }
-                        }
+                        clause[q] = mkLit(m_stateName(u, q), false);
                     }
+                    addAtMostOne(u, clause, firstNewState);
                 }
 
                 // Equation 4.3.3
+                // For every ua, va in Pref, p, q in Q, we must have (x_{u, p} AND x_{v, p}) => (x_{ua, q} <=> x_{va, q})
+                // The clauses are symmetric in u and v and always hold if u = v: we only need the pairs u < v (see computePrefixPairs)
+                // If u and v are in conflict, they can not reach the same state. We then directly write NOT (x_{u, p} AND x_{v, p})
+                vec<Lit> inequality(2);
                 clause.clear();
                 clause.growTo(4);
-                for (const auto &ua : m_prefixes) {
-                    for (const auto &va : m_prefixes) {
+                for (const PrefixPair &pair : prefixPairs()) {
+                    const unsigned int u = pair.u;
+                    const unsigned int v = pair.v;
+                    if (!pair.compatible) {
+                        for (unsigned int p = firstNewState ; p < m_numberStates ; p++) {
+                            inequality[0] = mkLit(m_stateName(u, p), true);
+                            inequality[1] = mkLit(m_stateName(v, p), true);
+                            addClause(inequality);
+                        }
+                        continue;
+                    }
+
+                    for (const unsigned int &ua : m_prefixTree[u].children) {
+                        const unsigned int va = m_prefixTree.getChild(v, m_prefixTree[ua].symbol);
                         // We must have that ua and va end with the same symbol
-                        // We must have at least one symbol as well
-                        if (ua.size() > 0 && va.size() > 0 && ua.at(ua.size() - 1) == va.at(va.size() - 1)) {
-                            std::string u = ua.substr(0, ua.size() - 1);
-                            std::string v = va.substr(0, va.size() - 1);
-                            // Now, we can create every clause
-                            for (unsigned int p = 0 ; p < m_numberStates ; p++) {
-                                for (unsigned int q = 0 ; q < m_numberStates ; q++) {
-                                    Var upState = m_stateName.find(std::make_pair(u, p))->second;
-                                    Var vpState = m_stateName.find(std::make_pair(v, p))->second;
-                                    Var uaqState = m_stateName.find(std::make_pair(ua, q))->second;
-                                    Var vaqState = m_stateName.find(std::make_pair(va, q))->second;
-
-                                    clause[0] = mkLit(upState, true);
-                                    clause[1] = mkLit(vpState, true);
-                                    clause[2] = mkLit(uaqState, false);
-                                    clause[3] = mkLit(vaqState, true);
-                                    addClause(clause);
-
-                                    clause[0] = mkLit(upState, true);
-                                    clause[1] = mkLit(vpState, true);
-                                    clause[2] = mkLit(uaqState, true);
-                                    clause[3] = mkLit(vaqState, false);
-                                    addClause(clause);
+                        if (va == PrefixTree::none) {
+                            continue;
+                        }
+                        // Now, we can create every clause
+                        for (unsigned int p = 0 ; p < m_numberStates ; p++) {
+                            for (unsigned int q = 0 ; q < m_numberStates ; q++) {
+                                if (p < firstNewState && q < firstNewState) {
+                                    continue;
                                 }
+                                Var upState = m_stateName(u, p);
+                                Var vpState = m_stateName(v, p);
+                                Var uaqState = m_stateName(ua, q);
+                                Var vaqState = m_stateName(va, q);
+
+                                clause[0] = mkLit(upState, true);
+                                clause[1] = mkLit(vpState, true);
+                                clause[2] = mkLit(uaqState, false);
+                                clause[3] = mkLit(vaqState, true);
+                                addClause(clause);
+
+                                clause[0] = mkLit(upState, true);
+                                clause[1] = mkLit(vpState, true);
+                                clause[2] = mkLit(uaqState, true);
+                                clause[3] = mkLit(vaqState, false);
+                                addClause(clause);
                             }
                         }
                     }
@@ -99,77 +109,40 @@ namespace gsjj {
                 // Equation 4.3.4
                 clause.clear();
                 clause.growTo(2);
-                for (const auto &u : m_Sp) {
-                    for (const auto &v : m_Sm) {
-                        for (unsigned int q = 0 ; q < m_numberStates ; q++) {
-                            Var uqState = m_stateName.find(std::make_pair(u, q))->second;
-                            Var vqState = m_stateName.find(std::make_pair(v, q))->second;
-
-                            clause[0] = mkLit(uqState, true);
-                            clause[1] = mkLit(vqState, true);
+                for (const auto &u : m_SpIds) {
+                    for (const auto &v : m_SmIds) {
+                        for (unsigned int q = firstNewState ; q < m_numberStates ; q++) {
+                            clause[0] = mkLit(m_stateName(u, q), true);
+                            clause[1] = mkLit(m_stateName(v, q), true);
 
                             addClause(clause);
                         }
                     }
                 }
-            }
-
-            std::unique_ptr<DFA<char>> UnaryCNFMethod::toDFA(const Minisat::vec<Minisat::lbool> &model) const {
-                // First, we seek the initial state
-                unsigned int initial = 0;
-                for (unsigned int i = 0 ; i < m_numberStates ; i++) {
-                    Var v = m_stateName.find(std::make_pair("", i))->second;
-                    if (model[v] == l_True) {
-                        initial = i;
-                    }
-                }
 
-                // The initial state is accepting if epsilon is in Sp
-                std::unique_ptr<DFA<char>> dfa = std::make_unique<DFA<char>>(initial, m_Sp.find("") != m_Sp.end());
-
-                // We create every state (and we seek the accepting states)
-                for (unsigned int q = 0 ; q < m_numberStates ; q++) {
-                    if (q != initial) {
-                        bool accepting = false;
-                        for (const auto &u : m_Sp) {
-                            Var var = m_stateName.find(std::make_pair(u, q))->second;
-                            if (model[var] == l_True) {
-                                accepting = true;
-                                break;
-                            }
-                        }
-
-                        dfa->addState(q, accepting);
-                    }
+                // Symmetry breaking
+                // The i-th prefix of the clique must reach the state i
+                clause.clear();
+                clause.growTo(1);
+                for (unsigned int i = firstNewState ; i < m_numberStates && i < m_clique.size() ; i++) {
+                    clause[0] = mkLit(m_stateName(m_prefixTree.find(m_clique[i]), i), false);
+                    addClause(clause);
                 }
+            }
 
-                // Now, we create delta (the transitions)
-                for (unsigned int i = 0 ; i < m_numberStates ; i++) {
-                    for (const char &a : m_alphabet) {
-                        bool found = false;
-                        for (unsigned int j = 0 ; j < m_numberStates ; j++) {
-                            for (const auto &ua : m_prefixes) {
-                                if (ua.size() > 0 && ua.at(ua.size() - 1) == a){
-                                    std::string u = ua.substr(0, ua.size() - 1);
-
-                                    Var uiState = m_stateName.find(std::make_pair(u, i))->second;
-                                    Var uajState = m_stateName.find(std::make_pair(ua, j))->second;
-
-                                    if (model[uiState] == l_True && model[uajState] == l_True) {
-                                        found = true;
-                                        dfa->addTransition(i, a, j);
-                                    }
-                                }
-                            }
-                        }
-
-                        if (!found) {
-                            dfa->addTransition(i, a, i);
+            std::unique_ptr<DFA<char>> UnaryCNFMethod::toDFA(const Minisat::vec<Minisat::lbool> &model) const {
+                // The state reached by each prefix
+                std::vector<unsigned int> states(m_prefixTree.size(), 0);
+                for (unsigned int u = 0 ; u < m_prefixTree.size() ; u++) {
+                    for (unsigned int q = 0 ; q < m_numberStates ; q++) {
+                        if (model[m_stateName(u, q)] == l_True) {
+                            states[u] = q;
+                            break;
                         }
                     }
                 }
 
-                return dfa;
+                return dfaFromStates(states);
             }
         }
     }
@@ -5,11 +5,15 @@
 #include "gsjj/passive/MethodFactory.h"
 
 #include "gsjj/passive/SMT/BiermannMethod.h"
+#include "gsjj/passive/SMT/BiermannBVMethod.h"
 #include "gsjj/passive/SMT/NeiderJansenMethod.h"
+#include "gsjj/passive/SMT/NeiderJansenBVMethod.h"
 
 #include "gsjj/passive/CNF/UnaryCNFMethod.h"
 #include "gsjj/passive/CNF/BinaryCNFMethod.h"
+#include "gsjj/passive/CNF/BinaryDirectCNFMethod.h"
 #include "gsjj/passive/CNF/HeuleVerwerCNFMethod.h"
+#include "gsjj/passive/CNF/HeuleVerwerBFSCNFMethod.h"
 
 #include "gsjj/passive/NonCNF/UnaryNonCNFMethod.h"
 #include "gsjj/passive/NonCNF/BinaryNonCNFMethod.h"
@@ -22,19 +26,21 @@ using namespace Minisat;
 namespace gsjj {
     namespace passive {
 
-        Method::Method(const std::set<std::string> &SpSet, const std::set<std::string> &SmSet, const std::set<std::string> &SSet, const std::set<std::string> &prefixesSet, const std::set<char> &alphabetSet, unsigned int n) :
-            m_Sp(SpSet),
-            m_Sm(SmSet),
+        Method::Method(std::shared_ptr<const Sample> sample, unsigned int n) :
+            m_sample(std::move(sample)),
+            m_Sp(m_sample->getSp()),
+            m_Sm(m_sample->getSm()),
             m_numberStates(n),
-            m_S(SSet),
-            m_prefixes(prefixesSet),
-            m_alphabet(alphabetSet),
+            m_alphabet(m_sample->getAlphabet()),
+            m_prefixTree(m_sample->getPrefixTree()),
+            m_SpIds(m_sample->getSpIds()),
+            m_SmIds(m_sample->getSmIds()),
+            m_symbols(m_sample->getSymbols()),
             m_triedSolve(false),
             m_hasSolution(false),
             m_cpuTimeStart(0),
             m_cpuTimeEnd(0)
         {
-
         }
 
         Method::~Method() {
@@ -47,5 +53,59 @@ namespace gsjj {
         double Method::timeToSolve() const {
             return m_cpuTimeEnd - m_cpuTimeStart;
         }
+
+        bool Method::enableIncrementalMode() {
+            return false;
+        }
+
+        bool Method::incrementNumberOfStates() {
+            return false;
+        }
+
+        void Method::interrupt() {
+
+        }
+
+        std::unique_ptr<DFA<char>> Method::dfaFromStates(const std::vector<unsigned int> &states) const {
+            const unsigned int numberSymbols = m_symbols.size();
+
+            std::vector<bool> accepting(m_numberStates, false);
+            for (const auto &u : m_SpIds) {
+                accepting[states[u]] = true;
+            }
+
+            // The empty word is the root of the tree
+            const unsigned int initial = states[0];
+            std::unique_ptr<DFA<char>> dfa = std::make_unique<DFA<char>>(initial, accepting[initial], m_numberStates, numberSymbols);
+            for (unsigned int q = 0 ; q < m_numberStates ; q++) {
+                if (q != initial) {
+                    dfa->addState(q, accepting[q]);
+                }
+            }
+
+            // The transition read by ua goes from the state of u to the state of ua
+            std::vector<bool> defined(m_numberStates * numberSymbols, false);
+            for (unsigned int ua = 1 ; ua < m_prefixTree.size() ; ua++) {
+                const unsigned int p = states[m_prefixTree[ua].parent];
+                const unsigned int a = symbolIndex(m_prefixTree[ua].symbol);
+                if (!defined[p * numberSymbols + a]) {
+                    defined[p * numberSymbols + a] = true;
+                    dfa->addTransition(p, m_symbols[a], states[ua]);
+                }
+            }
+            for (unsigned int p = 0 ; p < m_numberStates ; p++) {
+                for (unsigned int a = 0 ; a < numberSymbols ; a++) {
+                    if (!defined[p * numberSymbols + a]) {
+                        dfa->addTransition(p, m_symbols[a], p);
+                    }
+                }
+            }
+
+            return dfa;
+        }
+
+        void Method::setSymmetryBreakingClique(const std::vector<std::string> &clique) {
+            m_clique = clique;
+        }
     }
 }
\ No newline at end of file
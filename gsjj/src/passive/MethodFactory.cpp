@@ -2,7 +2,11 @@
 #include <iostream>
 #include <stdexcept>
 #include <future>
+#include <mutex>
+#include <condition_variable>
+#include <thread>
 #include <cmath>
+#include <exception>
 
 #include "gsjj/passive/MethodFactory.h"
 #include "gsjj/passive/utils.h"
@@ -28,18 +32,18 @@ namespace gsjj {
             }
         }
 
-        MethodFactory::MethodPtr MethodFactory::create(const std::string &name, unsigned int n, const std::set<std::string> &Sp, const std::set<std::string> &Sm, const std::set<std::string> &S, const std::set<std::string> &prefixes, const std::set<char> &alphabet) {
+        MethodFactory::MethodPtr MethodFactory::create(const std::string &name, unsigned int n, std::shared_ptr<const Sample> sample) {
             auto itr = s_methodsMap.find(name);
             if (itr == s_methodsMap.end()) {
                 return nullptr;
             }
             else {
-                return itr->second(Sp, Sm, S, prefixes, alphabet, n);
+                return itr->second(std::move(sample), n);
             }
         }
 
-        std::unique_ptr<Method> constructMethodTrigger(const std::string &name, unsigned int n, const std::set<std::string> &Sp, const std::set<std::string> &Sm, const std::set<std::string> &S, const std::set<std::string> &prefixes, const std::set<char> &alphabet, const std::chrono::seconds &timeLimit, std::atomic_bool &stopTrigger, const bool *stopPointer) {
-            std::unique_ptr<Method> method = MethodFactory::create(name, n, Sp, Sm, S, prefixes, alphabet);
+        std::unique_ptr<Method> constructMethodTrigger(const std::string &name, unsigned int n, const std::shared_ptr<const Sample> &sample, const std::chrono::seconds &timeLimit, std::atomic_bool &stopTrigger, const bool *stopPointer) {
+            std::unique_ptr<Method> method = MethodFactory::create(name, n, sample);
             if (!method) {
                 throw std::invalid_argument("Unknown method type: " + name);
             }
@@ -48,72 +52,316 @@ namespace gsjj {
         }
 
         std::unique_ptr<Method> constructMethod(const std::string &method, unsigned int n, const std::set<std::string> &Sp, const std::set<std::string> &Sm) {
-            std::set<std::string> S = computeS(Sp, Sm);
-            std::set<std::string> prefixes = computePrefixes(S);
-            std::set<char> alphabet = computeAlphabet(S);
-            
-            return std::move(constructMethod(method, n, Sp, Sm, S, prefixes, alphabet));
+            return std::move(constructMethod(method, n, std::make_shared<const Sample>(Sp, Sm)));
         }
 
-        std::unique_ptr<Method> constructMethod(const std::string &method, unsigned int n, const std::set<std::string> &Sp, const std::set<std::string> &Sm, const std::set<std::string> &S, const std::set<std::string> &prefixes, const std::set<char> &alphabet) {
-            return std::move(constructMethodTrigger(method, n, Sp, Sm, S, prefixes, alphabet, noLimit, falseStopTrigger, &falseStopBool));
+        std::unique_ptr<Method> constructMethod(const std::string &method, unsigned int n, std::shared_ptr<const Sample> sample) {
+            return std::move(constructMethodTrigger(method, n, sample, noLimit, falseStopTrigger, &falseStopBool));
         }
 
-        std::pair<std::unique_ptr<Method>, bool> constructMethod(const std::string &method, const std::set<std::string> &Sp, const std::set<std::string> &Sm, const std::chrono::seconds &timeLimit, long double *timeTaken) {
-            std::set<std::string> S = computeS(Sp, Sm);
-            std::set<std::string> prefixes = computePrefixes(S);
-            std::set<char> alphabet = computeAlphabet(S);
-            
-            return constructMethod(method, Sp, Sm, S, prefixes, alphabet, timeLimit, timeTaken);
+        std::pair<std::unique_ptr<Method>, bool> constructMethod(const std::string &method, const std::set<std::string> &Sp, const std::set<std::string> &Sm, const std::chrono::seconds &timeLimit, long double *timeTaken, bool incremental, unsigned int numberThreads) {
+            return constructMethod(method, std::make_shared<const Sample>(Sp, Sm), timeLimit, timeTaken, incremental, numberThreads);
         }
 
-        std::pair<std::unique_ptr<Method>, bool> constructMethod(const std::string &method, const std::set<std::string> &Sp, const std::set<std::string> &Sm, const std::set<std::string> &S, const std::set<std::string> &prefixes, const std::set<char> &alphabet, const std::chrono::seconds &timeLimit, long double *timeTaken) {
-            std::atomic_bool stopTrigger(false);
-            bool stopBool(false);
+        std::pair<std::unique_ptr<Method>, bool> constructMethod(const std::string &method, std::shared_ptr<const Sample> sample, const std::chrono::seconds &timeLimit, long double *timeTaken, bool incremental, unsigned int numberThreads) {
+            LinearSearch strategy;
+            return constructMethod(method, std::move(sample), strategy, timeLimit, timeTaken, incremental, numberThreads);
+        }
+
+        std::pair<std::unique_ptr<Method>, bool> constructMethod(const std::string &method, const std::set<std::string> &Sp, const std::set<std::string> &Sm, SearchStrategy &strategy, const std::chrono::seconds &timeLimit, long double *timeTaken, bool incremental, unsigned int numberThreads) {
+            return constructMethod(method, std::make_shared<const Sample>(Sp, Sm), strategy, timeLimit, timeTaken, incremental, numberThreads);
+        }
 
+        /**
+         * The flags used to stop a search running in another thread.
+         *
+         * It also knows the method that is currently solving, to interrupt it (see Method::interrupt)
+         */
+        class SearchControl {
+        public:
+            SearchControl() :
+                stopTrigger(false),
+                stopBool(false),
+                m_current(nullptr)
+            {
+            }
+
+            /**
+             * Asks the search to stop as soon as possible. It can be called from any thread
+             */
+            void stop() {
+                stopTrigger.store(true);
+                stopBool = true;
+                std::lock_guard<std::mutex> lock(m_mutex);
+                if (m_current) {
+                    m_current->interrupt();
+                }
+            }
+
+            /**
+             * Declares the method that is solving (or nullptr once it's done)
+             * @param method The method
+             */
+            void setCurrent(Method *method) {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                m_current = method;
+            }
+
+        public:
+            std::atomic_bool stopTrigger;
+            bool stopBool;
+
+        private:
+            std::mutex m_mutex;
+            Method *m_current;
+        };
+
+        /**
+         * Runs the search for the minimal number of states.
+         *
+         * It's the body of the thread started by constructMethod.
+         * @param sharedLowerBound If not nullptr, the numbers of states below this value are known to be unsatisfiable (another search proved it). The unsatisfiable numbers of states found by this search are published in it
+         * @param bestPossible Receives the method with the smallest number of states for which a DFA was found
+         */
+        static void searchMinimalNumberOfStates(const std::string &method, const std::shared_ptr<const Sample> &sample, SearchStrategy &strategy, const std::chrono::seconds &timeLimit, long double *timeTaken, bool incremental, SearchControl &control, std::atomic_uint *sharedLowerBound, std::unique_ptr<Method> &bestPossible) {
             std::chrono::seconds remainingTime(timeLimit);
 
-            std::unique_ptr<Method> bestPossible = nullptr;
+            // In incremental mode, the previous method is grown up to the next number of states instead of being rebuilt (if the number grows)
+            bool reusable = false;
+            std::unique_ptr<Method> toTry = nullptr;
+            unsigned int n;
+            while (!control.stopTrigger && (n = strategy.nextNumberOfStates()) != 0) {
+                // Another search already proved that there is no DFA with n states
+                if (sharedLowerBound && n < sharedLowerBound->load()) {
+                    strategy.report(n, false, 0, 0);
+                    continue;
+                }
 
-            // We use a thread to be able to stop the method when the time limit is reached
-            std::packaged_task<void()> task([&]() {
-                unsigned int n = 1;
-                bool cont = true;
-                while (cont && !stopTrigger) {
-                    std::unique_ptr<Method> toTry = constructMethodTrigger(method, n, Sp, Sm, S, prefixes, alphabet, remainingTime, stopTrigger, &stopBool);
+                bool grown = reusable && toTry && toTry->numberOfStates() <= n;
+                while (grown && toTry->numberOfStates() < n) {
+                    grown = toTry->incrementNumberOfStates();
+                }
+                if (!grown) {
+                    toTry = constructMethodTrigger(method, n, sample, remainingTime, control.stopTrigger, &control.stopBool);
+                    toTry->setSymmetryBreakingClique(sample->getConflictClique());
+                    reusable = incremental && toTry->enableIncrementalMode();
+                }
+
+                control.setCurrent(toTry.get());
+                // The stop may have been asked before the method could be interrupted
+                bool success = !control.stopTrigger && toTry->solve();
+                control.setCurrent(nullptr);
+                double time = toTry->timeToSolve();
+                if (timeTaken) {
+                    *timeTaken += time;
+                }
+                remainingTime -= std::chrono::seconds(int(std::floor(time)));
+                // To make sure CVC4 does not think it has an unlimited available time
+                if (remainingTime.count() <= 0) {
+                    if (timeLimit == std::chrono::seconds(0)) {
+                        remainingTime = std::chrono::seconds(0);
+                    }
+                    else {
+                        remainingTime = std::chrono::seconds(1);
+                    }
+                }
+
+                // A probe stopped by the time limit does not tell anything
+                if (control.stopTrigger) {
+                    break;
+                }
+
+                unsigned int usedStates = 0;
+                if (success) {
+                    auto dfa = toTry->constructDFA();
+                    if (dfa) {
+                        usedStates = dfa->getNumberOfReachableStates();
+                    }
+                    if (!bestPossible || n < bestPossible->numberOfStates()) {
+                        bestPossible = std::move(toTry);
+                    }
+                    else {
+                        toTry = nullptr;
+                    }
+                }
+                else if (sharedLowerBound) {
+                    // We publish that n is unsatisfiable
+                    unsigned int known = sharedLowerBound->load();
+                    while (known < n + 1 && !sharedLowerBound->compare_exchange_weak(known, n + 1)) {
+                    }
+                }
+                strategy.report(n, success, time, usedStates);
+            }
+        }
+
+        /**
+         * Runs the search for the minimal number of states by solving several numbers of states at the same time.
+         *
+         * The numbers of states are given in increasing order from the lower bound to numberThreads workers. Since a DFA with n states can always be completed into a DFA with n + 1 states:
+         *  - if a DFA with n states exists, the workers with more than n states are cancelled
+         *  - if no DFA with n states exists, the workers with less than n states are cancelled and the next number of states is started
+         *
+         * Each worker has its own stopping flags (see SearchControl). At most numberThreads workers exist at the same time, including the cancelled workers that did not stop yet. The strategy only records the probes and the bounds.
+         * @param control The flags of the whole search. The workers are stopped as soon as stopTrigger is set
+         * @param bestPossible Receives the method with the smallest number of states for which a DFA was found
+         */
+        static void searchSpeculatively(const std::string &method, const std::shared_ptr<const Sample> &sample, SearchStrategy &strategy, const std::chrono::seconds &timeLimit, long double *timeTaken, unsigned int numberThreads, SearchControl &control, std::unique_ptr<Method> &bestPossible) {
+            struct Worker {
+                unsigned int n;
+                SearchControl control;
+                std::thread thread;
+                bool done = false;
+                bool success = false;
+                double time = 0;
+                std::unique_ptr<Method> method = nullptr;
+                std::exception_ptr exception = nullptr;
+            };
+
+            std::mutex mutex;
+            std::condition_variable doneCondition;
+            std::vector<std::unique_ptr<Worker>> workers;
+            // The next number of states to give to a worker
+            unsigned int next = strategy.getLowerBound();
+            // The number of states of the trivial DFA is always satisfiable
+            const unsigned int last = std::max<unsigned int>(sample->getPrefixTree().size(), strategy.getLowerBound());
+
+            auto launch = [&](unsigned int n) {
+                workers.push_back(std::make_unique<Worker>());
+                Worker *worker = workers.back().get();
+                worker->n = n;
+                worker->thread = std::thread([&, worker]() {
+                    try {
+                        std::unique_ptr<Method> toTry = constructMethodTrigger(method, worker->n, sample, timeLimit, worker->control.stopTrigger, &worker->control.stopBool);
+                        toTry->setSymmetryBreakingClique(sample->getConflictClique());
+                        worker->control.setCurrent(toTry.get());
+                        bool success = !worker->control.stopTrigger && toTry->solve();
+                        worker->control.setCurrent(nullptr);
+
+                        std::lock_guard<std::mutex> lock(mutex);
+                        worker->success = success;
+                        worker->time = toTry->timeToSolve();
+                        worker->method = std::move(toTry);
+                    }
+                    catch (...) {
+                        worker->control.setCurrent(nullptr);
+                        std::lock_guard<std::mutex> lock(mutex);
+                        worker->exception = std::current_exception();
+                    }
+                    std::lock_guard<std::mutex> lock(mutex);
+                    worker->done = true;
+                    doneCondition.notify_all();
+                });
+            };
+
+            auto isRunning = [](const std::unique_ptr<Worker> &worker) {
+                return !worker->control.stopTrigger;
+            };
+            // A cancelled worker keeps its thread (and its solver) until it notices it must stop. It's counted in the numberThreads workers until it is done (must be called with the mutex)
+            auto isBusy = [](const std::unique_ptr<Worker> &worker) {
+                return !worker->done || !worker->control.stopTrigger;
+            };
+
+            std::exception_ptr exception = nullptr;
+            while (!control.stopTrigger && !strategy.isFinished() && !exception) {
+                std::unique_lock<std::mutex> lock(mutex);
+
+                // We keep numberThreads workers busy, without going above the known upper bound
+                unsigned int upper = strategy.getUpperBound() == 0 ? last + 1 : strategy.getUpperBound();
+                next = std::max(next, strategy.getLowerBound());
+                auto canLaunch = [&]() {
+                    return next < upper && std::size_t(std::count_if(workers.begin(), workers.end(), isBusy)) < numberThreads;
+                };
+                while (canLaunch()) {
+                    launch(next++);
+                }
+                // Should not happen since the trivial DFA always exists
+                if (std::none_of(workers.begin(), workers.end(), isBusy)) {
+                    break;
+                }
+
+                // The time limit is checked by control: we wake up regularly to look at it
+                doneCondition.wait_for(lock, std::chrono::milliseconds(50), [&]() {
+                    return canLaunch() || std::any_of(workers.begin(), workers.end(), [&](const std::unique_ptr<Worker> &worker) {
+                        return worker->done && isRunning(worker);
+                    });
+                });
+
+                for (auto &worker : workers) {
+                    if (!worker->done || !isRunning(worker)) {
+                        continue;
+                    }
+                    // The worker is handled once
+                    worker->control.stopTrigger.store(true);
+                    if (worker->exception) {
+                        exception = worker->exception;
+                        continue;
+                    }
 
-                    bool success = toTry->solve();
                     if (timeTaken) {
-                        *timeTaken += toTry->timeToSolve();
+                        *timeTaken += worker->time;
                     }
-                    remainingTime -= std::chrono::seconds(int(std::floor(toTry->timeToSolve())));
-                    // To make sure CVC4 does not think it has an unlimited available time
-                    if (remainingTime.count() <= 0) {
-                        if (timeLimit == std::chrono::seconds(0)) {
-                            remainingTime = std::chrono::seconds(0);
+                    unsigned int usedStates = 0;
+                    if (worker->success) {
+                        auto dfa = worker->method->constructDFA();
+                        if (dfa) {
+                            usedStates = dfa->getNumberOfReachableStates();
                         }
-                        else {
-                            remainingTime = std::chrono::seconds(1);
+                        if (!bestPossible || worker->n < bestPossible->numberOfStates()) {
+                            bestPossible = std::move(worker->method);
                         }
                     }
+                    strategy.report(worker->n, worker->success, worker->time, usedStates);
+                }
 
-                    if (success) {
-                        bestPossible = std::move(toTry);
-                        cont = false;
+                // The workers whose number of states is outside of the bounds are useless
+                for (auto &worker : workers) {
+                    bool tooSmall = worker->n < strategy.getLowerBound();
+                    bool tooLarge = strategy.getUpperBound() != 0 && worker->n >= strategy.getUpperBound();
+                    if (!worker->done && (tooSmall || tooLarge)) {
+                        worker->control.stop();
                     }
-                    n++;
+                }
+            }
+
+            for (auto &worker : workers) {
+                worker->control.stop();
+            }
+            for (auto &worker : workers) {
+                worker->thread.join();
+            }
+            if (exception) {
+                std::rethrow_exception(exception);
+            }
+        }
+
+        std::pair<std::unique_ptr<Method>, bool> constructMethod(const std::string &method, std::shared_ptr<const Sample> sample, SearchStrategy &strategy, const std::chrono::seconds &timeLimit, long double *timeTaken, bool incremental, unsigned int numberThreads) {
+            SearchControl control;
+
+            std::unique_ptr<Method> bestPossible = nullptr;
+
+            // Prefixes in pairwise conflict must reach different states: it gives a lower bound and we can pin them
+            // The prefix tree acceptor (one state by prefix) is always consistent with the sample
+            strategy.start(sample->getPrefixTree().size(), sample->getConflictClique().size());
+
+            // We use a thread to be able to stop the method when the time limit is reached
+            std::packaged_task<void()> task([&]() {
+                if (numberThreads > 1) {
+                    searchSpeculatively(method, sample, strategy, timeLimit, timeTaken, numberThreads, control, bestPossible);
+                }
+                else {
+                    searchMinimalNumberOfStates(method, sample, strategy, timeLimit, timeTaken, incremental, control, nullptr, bestPossible);
                 }
             });
 
             std::future<void> future = task.get_future();
             std::thread t(std::move(task));
 
+            bool finished = true;
             // If there is no limit, we just start the thread and join
             if (timeLimit <= std::chrono::seconds(0)) {
                 future.wait();
                 t.join();
                 future.get(); // Allows to retrieve any thrown exception
-                return std::make_pair(std::move(bestPossible), true);
             }
             else {
                 // We use wait_for to wait for the thread to finish or for the timeLimit to be reached
@@ -123,16 +371,127 @@ namespace gsjj {
                 if (status == std::future_status::ready) {
                     t.join();
                     future.get(); // Allows to retrieve any thrown exception
-                    return std::make_pair(std::move(bestPossible), true);
                 }
                 else {
-                    stopTrigger.store(true);
-                    stopBool = true;
+                    control.stop();
                     t.join();
                     future.get(); // Allows to retrieve any thrown exception
-                    return std::make_pair(std::move(bestPossible), false);
+                    finished = false;
                 }
             }
+
+            // The stopping flags die with this function: the returned method must not look at them anymore
+            if (bestPossible) {
+                bestPossible->setStopTrigger(noLimit, falseStopTrigger, &falseStopBool);
+            }
+            return std::make_pair(std::move(bestPossible), finished);
+        }
+
+        std::pair<std::unique_ptr<Method>, bool> constructMethodPortfolio(const std::vector<std::string> &methods, const std::set<std::string> &Sp, const std::set<std::string> &Sm, const std::chrono::seconds &timeLimit, std::string *winner, bool incremental) {
+            return constructMethodPortfolio(methods, std::make_shared<const Sample>(Sp, Sm), timeLimit, winner, incremental);
+        }
+
+        std::pair<std::unique_ptr<Method>, bool> constructMethodPortfolio(const std::vector<std::string> &methods, std::shared_ptr<const Sample> sample, const std::chrono::seconds &timeLimit, std::string *winner, bool incremental) {
+            const std::size_t size = methods.size();
+            if (size == 0) {
+                throw std::invalid_argument("The portfolio must contain at least one method");
+            }
+
+            // Computed once for every member
+            const std::size_t cliqueSize = sample->getConflictClique().size();
+
+            // Every number of states below this value is known to be unsatisfiable
+            std::atomic_uint sharedLowerBound(1);
+
+            // Each member has its own flags, strategy and result
+            std::vector<std::unique_ptr<SearchControl>> controls;
+            std::vector<LinearSearch> strategies(size);
+            std::vector<std::unique_ptr<Method>> results(size);
+
+            // The first member to find the minimal number of states is the winner
+            std::mutex mutex;
+            std::condition_variable finishedCondition;
+            std::size_t numberFinished = 0;
+            std::size_t winnerIndex = size;
+            // If a member throws, the portfolio is stopped and the exception is rethrown
+            bool failed = false;
+
+            std::vector<std::future<void>> futures;
+            std::vector<std::thread> threads;
+            for (std::size_t i = 0 ; i < size ; i++) {
+                controls.push_back(std::make_unique<SearchControl>());
+                strategies[i].start(sample->getPrefixTree().size(), cliqueSize);
+
+                std::packaged_task<void()> task([&, i]() {
+                    auto notify = [&](bool thrown) {
+                        std::lock_guard<std::mutex> lock(mutex);
+                        numberFinished++;
+                        failed = failed || thrown;
+                        if (winnerIndex == size && results[i] && strategies[i].isFinished()) {
+                            winnerIndex = i;
+                        }
+                        finishedCondition.notify_all();
+                    };
+
+                    try {
+                        searchMinimalNumberOfStates(methods[i], sample, strategies[i], timeLimit, nullptr, incremental, *controls[i], &sharedLowerBound, results[i]);
+                    }
+                    catch (...) {
+                        notify(true);
+                        throw;
+                    }
+                    notify(false);
+                });
+                futures.push_back(task.get_future());
+                threads.emplace_back(std::move(task));
+            }
+
+            bool finished;
+            {
+                std::unique_lock<std::mutex> lock(mutex);
+                auto isOver = [&]() {
+                    return winnerIndex != size || failed || numberFinished == size;
+                };
+                if (timeLimit <= std::chrono::seconds(0)) {
+                    finishedCondition.wait(lock, isOver);
+                    finished = true;
+                }
+                else {
+                    finished = finishedCondition.wait_for(lock, timeLimit, isOver);
+                }
+            }
+
+            // The losers (and everyone, on timeout) are cancelled
+            for (auto &control : controls) {
+                control->stop();
+            }
+            for (auto &thread : threads) {
+                thread.join();
+            }
+            for (auto &future : futures) {
+                future.get(); // Allows to retrieve any thrown exception
+            }
+
+            // Like constructMethod, the best DFA found so far is kept when the search could not finish: it's not proven optimal
+            if (winnerIndex == size) {
+                finished = false;
+                for (std::size_t i = 0 ; i < size ; i++) {
+                    if (results[i] && (winnerIndex == size || results[i]->numberOfStates() < results[winnerIndex]->numberOfStates())) {
+                        winnerIndex = i;
+                    }
+                }
+                if (winnerIndex == size) {
+                    return std::make_pair(nullptr, false);
+                }
+            }
+
+            if (winner) {
+                *winner = methods[winnerIndex];
+            }
+            // The stopping flags die with this function: the returned method must not look at them anymore
+            std::unique_ptr<Method> best = std::move(results[winnerIndex]);
+            best->setStopTrigger(noLimit, falseStopTrigger, &falseStopBool);
+            return std::make_pair(std::move(best), finished);
         }
     }
 }
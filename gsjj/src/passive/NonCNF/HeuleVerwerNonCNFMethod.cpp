@@ -6,19 +6,13 @@
 
 #include "gsjj/passive/NonCNF/HeuleVerwerNonCNFMethod.h"
 
-#include <iostream>
-#include <utility>
-#include <cmath>
 #include <vector>
-#include <fstream>
-#include <math.h>
-#include <boost/algorithm/string.hpp>
 
 namespace gsjj {
     namespace passive {
         namespace NonCNF {
-            HeuleVerwerNonCNFMethod::HeuleVerwerNonCNFMethod(const std::set<std::string> &SpSet, const std::set<std::string> &SmSet, const std::set<std::string> &SSet, const std::set<std::string> &prefixesSet, const std::set<char> &alphabetSet, unsigned int n) :
-                SATNonCNFMethod(SpSet, SmSet, SSet, prefixesSet, alphabetSet, n)
+            HeuleVerwerNonCNFMethod::HeuleVerwerNonCNFMethod(std::shared_ptr<const Sample> sample, unsigned int n) :
+                SATNonCNFMethod(sample, n)
             {
                 s_registered = s_registered;
             }
@@ -31,225 +25,141 @@ namespace gsjj {
                 return "heuleNonCNF";
             }
 
-            bool HeuleVerwerNonCNFMethod::createFormula(std::ostream &stream){
-                std::string formula = "";
+            LimbooleNode *HeuleVerwerNonCNFMethod::createFormula(){
+                const unsigned int numberPrefixes = m_prefixTree.size();
+                const unsigned int numberSymbols = m_symbols.size();
+
+                // The formula is built from scratch for every solve
+                m_xVars = StateTable<LimbooleNode*>();
+                m_xVars.resize(numberPrefixes, m_numberStates);
+                m_dVars = StateTable<LimbooleNode*>();
+                m_dVars.resize(m_numberStates * numberSymbols, m_numberStates);
+                m_fVars.resize(m_numberStates);
+                for (unsigned int q = 0 ; q < m_numberStates ; q++) {
+                    for (unsigned int u = 0 ; u < numberPrefixes ; u++) {
+                        m_xVars(u, q) = newVariable();
+                    }
+                    for (unsigned int pa = 0 ; pa < m_numberStates * numberSymbols ; pa++) {
+                        m_dVars(pa, q) = newVariable();
+                    }
+                    m_fVars[q] = newVariable();
+                }
+
+                LimbooleNode *formula = nullptr;
+
                 //Equation 4.5.1
-                if (m_numberStates > 1) {
-                    for (unsigned int p = 0; p < m_numberStates; p++){
-                        formula += " ( ";
-                        for (const char &a : m_alphabet){
-                            formula += " ( ";
-                            for (unsigned int q = 0; q < m_numberStates; q++){
-                                for (unsigned int r = 0; r < m_numberStates; r++){
-                                    //r is q' in the report
-                                    if (q != r){
-                                        formula += "! ( d_" + std::to_string(p) + "_" + a + "_" + std::to_string(q) + 
-                                                    " & d_" + std::to_string(p) + "_" + a + "_" + std::to_string(r) + " )";
-                                        formula += " &\n";
-                                    }
-                                }
+                // The constraint is symmetric in q and r: we only need the pairs q < r
+                for (unsigned int p = 0; p < m_numberStates; p++){
+                    for (unsigned int a = 0; a < numberSymbols; a++){
+                        for (unsigned int q = 0; q < m_numberStates; q++){
+                            for (unsigned int r = q + 1; r < m_numberStates; r++){
+                                //r is q' in the report
+                                formula = newAnd(formula, newNot(newAnd(m_dVars(p * numberSymbols + a, q), m_dVars(p * numberSymbols + a, r))));
                             }
-                            formula = formula.substr(0, formula.length() - 3);
-                            formula += " ) &\n";
                         }
-                        formula = formula.substr(0, formula.length() - 3);
-                        formula += " ) &\n";
                     }
-
-                    formula = formula.substr(0, formula.length() - 3);
-                    stream << formula;
-
-                    formula = " &\n";
                 }
 
                 //Equation 4.5.2
-                for (const auto &u : m_prefixes) {
-                    formula += " ( ";
+                for (unsigned int u = 0 ; u < numberPrefixes ; u++) {
+                    LimbooleNode *clause = nullptr;
                     for (unsigned int q = 0 ; q < m_numberStates ; q++) {
-                        formula += "x_" + u + "_" + std::to_string(q);
-                        if (q != m_numberStates - 1){
-                            formula += " | ";
-                        }
+                        clause = newOr(clause, m_xVars(u, q));
                     }
-                    formula += " ) &\n";
+                    formula = newAnd(formula, clause);
                 }
 
-                formula = formula.substr(0, formula.length() - 3);
-                stream << formula;
-
                 //Equation 4.5.3
-                formula = " &\n";
-                for (const auto &ua : m_prefixes) {
-                    if (ua.size() > 0) {
-                        const std::string &u = ua.substr(0, ua.size() - 1);
-                        const char &a = ua.at(ua.size() - 1);
-
-                        for (unsigned int p = 0 ; p < m_numberStates ; p++) {
-                            for (unsigned int q = 0 ; q < m_numberStates ; q++) {
-                                formula += "( ( x_" + u + "_" + std::to_string(p) + 
-                                            " & d_" + std::to_string(p) + "_" + a + "_" + std::to_string(q) + " ) -> x_" +
-                                            ua + "_" + std::to_string(q) + " )";
-                                formula += " &\n";
-                            }
+                // The root (the empty word) is the only prefix without a last symbol
+                for (unsigned int ua = 1 ; ua < numberPrefixes ; ua++) {
+                    if (mustStop && *mustStop) {
+                        return nullptr;
+                    }
+                    const unsigned int u = m_prefixTree[ua].parent;
+                    const unsigned int a = symbolIndex(m_prefixTree[ua].symbol);
+
+                    for (unsigned int p = 0 ; p < m_numberStates ; p++) {
+                        for (unsigned int q = 0 ; q < m_numberStates ; q++) {
+                            formula = newAnd(formula, newImplies(newAnd(m_xVars(u, p), m_dVars(p * numberSymbols + a, q)), m_xVars(ua, q)));
                         }
                     }
                 }
 
-                formula = formula.substr(0, formula.length() - 3);
-                stream << formula;
-
                 //Equation 4.5.4
-                formula = " &\n";
                 for (unsigned int q = 0; q < m_numberStates; q++){
-                    for (const auto &u : m_Sp){
-                        formula += "( x_" + u + "_" + std::to_string(q) + " -> f_" + std::to_string(q) + " )";
-                        formula += " &\n";
+                    for (const auto &u : m_SpIds){
+                        formula = newAnd(formula, newImplies(m_xVars(u, q), m_fVars[q]));
                     }
 
-                    for (const auto &u : m_Sm){
-                        formula += "( x_" + u + "_" + std::to_string(q) + " -> ! f_" + std::to_string(q) + " )";
-                        formula += " &\n";
+                    for (const auto &u : m_SmIds){
+                        formula = newAnd(formula, newImplies(m_xVars(u, q), newNot(m_fVars[q])));
                     }
                 }
 
-                formula = formula.substr(0, formula.length() - 3);
-                stream << formula;
-
                 //Equation 4.5.5
-                formula = " &\n";
                 for (unsigned int p = 0; p < m_numberStates; p++){
-                    for (const char &a : m_alphabet){
-                        formula += "( ";
+                    for (unsigned int a = 0; a < numberSymbols; a++){
+                        LimbooleNode *clause = nullptr;
                         for (unsigned int q = 0; q < m_numberStates; q++){
-                            formula += "d_" + std::to_string(p) + "_" + a + "_" + std::to_string(q);
-                            formula += " | ";
+                            clause = newOr(clause, m_dVars(p * numberSymbols + a, q));
                         }
-                        formula = formula.substr(0, formula.length() - 3);
-                        formula += ") &\n";
+                        formula = newAnd(formula, clause);
                     }
                 }
 
-                formula = formula.substr(0, formula.length() - 3);
-                stream << formula;
-
                 //Equation 4.5.6
-                formula = " &\n";
-                for (const auto &u : m_prefixes) {
+                // Symmetric in p and q as well
+                for (unsigned int u = 0 ; u < numberPrefixes ; u++) {
                     for (unsigned int p = 0 ; p < m_numberStates ; p++) {
-                        for (unsigned int q = 0 ; q < m_numberStates ; q++) {
-                            if (p != q) {
-                                formula += "( ! ( x_" + u + "_" + std::to_string(p) + " & x_" +
-                                            u + "_" + std::to_string(q) + " ) )";
-                                formula += " &\n";
-                            }
+                        for (unsigned int q = p + 1 ; q < m_numberStates ; q++) {
+                            formula = newAnd(formula, newNot(newAnd(m_xVars(u, p), m_xVars(u, q))));
                         }
                     }
                 }
 
-                formula = formula.substr(0, formula.length() - 3);
-                stream << formula;
-
                 //Equation 4.5.7
-                formula = " &\n";
-                for (const auto &ua : m_prefixes) {
-                    if (ua.size() > 0) {
-                        const std::string &u = ua.substr(0, ua.size() - 1);
-                        const char &a = ua.at(ua.size() - 1);
-
-                        for (unsigned int p = 0 ; p < m_numberStates ; p++) {
-                            for (unsigned int q = 0 ; q < m_numberStates ; q++) {
-                                formula += "( ( x_" + u + "_" + std::to_string(p) + " & " + "x_" + ua + "_" + std::to_string(q) + " ) "
-                                            + "-> d_" + std::to_string(p) + "_" + a + "_" + std::to_string(q) + " ) ";
-                                formula += "&\n";
-                            }
+                for (unsigned int ua = 1 ; ua < numberPrefixes ; ua++) {
+                    const unsigned int u = m_prefixTree[ua].parent;
+                    const unsigned int a = symbolIndex(m_prefixTree[ua].symbol);
+
+                    for (unsigned int p = 0 ; p < m_numberStates ; p++) {
+                        for (unsigned int q = 0 ; q < m_numberStates ; q++) {
+                            formula = newAnd(formula, newImplies(newAnd(m_xVars(u, p), m_xVars(ua, q)), m_dVars(p * numberSymbols + a, q)));
                         }
                     }
                 }
 
-                formula = formula.substr(0, formula.length() - 3);
-                stream << formula;
-
-                return true;
+                return formula;
             }
 
-            std::unique_ptr<DFA<char>> HeuleVerwerNonCNFMethod::toDFA(std::istream &stream) const
+            std::unique_ptr<DFA<char>> HeuleVerwerNonCNFMethod::toDFA() const
             {
-                //First, we have to read the solution
-                std::string line;
-                // std::map<std::string, unsigned int> words_states;
-                // std::vector<unsigned int> final_states;
-                std::vector<std::vector<std::string>> d_vars;
-                std::vector<unsigned int> f_vars;
-
+                const unsigned int numberSymbols = m_symbols.size();
                 std::unique_ptr<DFA<char>> dfa;
 
-                while(std::getline(stream, line)){
-                    //If there is a variable on this line
-                    if (line.at(0) == 'x'){
-                        std::vector<std::string> results;
-                        std::vector<std::string> results_2;
-                        //We split the line to get var - = - assignationOfTheVar
-                        boost::split(results, line, [](char c){return c == ' ';});
-                        //We split the var to get x - pref - stateNumber
-                        boost::split(results_2, results[0], [](char c){return c == '_';});
-                        // auto pair = std::make_pair(results_2[1], std::stoi(results_2[2]));
-                        // m_state_bit.emplace(state(pair, std::stoi(results[2])));
-                        if (std::stoi(results[2]) == 1 && results_2[1] == ""){
-                            dfa = std::make_unique<DFA<char>>(std::stoi(results_2[2]), m_Sp.find("") != m_Sp.end());
-                        }
-                    }
-                    if (line.at(0) == 'd'){
-                        std::vector<std::string> results;
-                        std::vector<std::string> results_2;
-                        //We split the line to get var - = - assignationOfTheVar
-                        boost::split(results, line, [](char c){return c == ' ';});
-                        //We split the var to get d - p - a - q
-                        boost::split(results_2, results[0], [](char c){return c == '_';});
-                        // auto pair = std::make_pair(results_2[1], std::stoi(results_2[2]));
-                        // m_state_bit.emplace(state(pair, std::stoi(results[2])));
-                        if(std::stoi(results[2]) == 1){
-                            std::vector<std::string> my_vec;
-                            my_vec.push_back(results_2[1]);
-                            my_vec.push_back(results_2[2]);
-                            my_vec.push_back(results_2[3]);
-                            d_vars.push_back(my_vec);
-                        }
-                    }
-                    if (line.at(0) == 'f'){
-                        std::vector<std::string> results;
-                        std::vector<std::string> results_2;
-                        //We split the line to get var - = - assignationOfTheVar
-                        boost::split(results, line, [](char c){return c == ' ';});
-                        //We split the var to get f - q
-                        boost::split(results_2, results[0], [](char c){return c == '_';});
-                        // auto pair = std::make_pair(results_2[1], std::stoi(results_2[2]));
-                        // m_state_bit.emplace(state(pair, std::stoi(results[2])));
-                        if (std::stoi(results[2]) == 1){
-                            f_vars.push_back(std::stoi(results_2[1]));
-                        }
+                // The empty word is the root of the prefix tree
+                for (unsigned int q = 0 ; q < m_numberStates ; q++) {
+                    if (value(m_xVars(0, q))) {
+                        dfa = std::make_unique<DFA<char>>(q, m_Sp.find("") != m_Sp.end(), m_numberStates, numberSymbols);
                     }
                 }
 
                 for(unsigned int i = 0; i < m_numberStates; i++){
-                    if(std::find(f_vars.begin(), f_vars.end(), i) != f_vars.end()){
-                        dfa->addState(i, true);
-                    }
-                    else{
-                        dfa->addState(i, false);
-                    }
+                    dfa->addState(i, value(m_fVars[i]));
                 }
 
-                for(const auto &vec : d_vars){
-                    const char *a = vec.at(1).c_str();
-                    dfa->addTransition(std::stoi(vec.at(0)), a[0], std::stoi(vec.at(2)));
+                for (unsigned int p = 0 ; p < m_numberStates ; p++) {
+                    for (unsigned int a = 0 ; a < numberSymbols ; a++) {
+                        for (unsigned int q = 0 ; q < m_numberStates ; q++) {
+                            if (value(m_dVars(p * numberSymbols + a, q))) {
+                                dfa->addTransition(p, m_symbols[a], q);
+                            }
+                        }
+                    }
                 }
 
                 return dfa;
             }
-
-            std::string HeuleVerwerNonCNFMethod::getFileName() const {
-                return "heule";
-            }
         }
     }
 }
\ No newline at end of file
@@ -1,8 +1,6 @@
 #include "gsjj/passive/NonCNF/SATNonCNFMethod.h"
 
-#include <fstream>
-#include <iostream>
-#include <functional>
+#include <cstdio>
 
 #include "MapleCOMSPS_LRB/utils/System.h"
 using namespace Minisat;
@@ -10,9 +8,11 @@ using namespace Minisat;
 namespace gsjj {
     namespace passive {
         namespace NonCNF {
-            SATNonCNFMethod::SATNonCNFMethod(const std::set<std::string> &SpSet, const std::set<std::string> &SmSet, const std::set<std::string> &SSet, const std::set<std::string> &prefixesSet, const std::set<char> &alphabetSet, unsigned int n) :
-                Method(SpSet, SmSet, SSet, prefixesSet, alphabetSet, n),
-                mustStop(nullptr) {
+            SATNonCNFMethod::SATNonCNFMethod(std::shared_ptr<const Sample> sample, unsigned int n) :
+                Method(sample, n),
+                mustStop(nullptr),
+                m_manager(nullptr, &limboole_release),
+                m_formula(nullptr) {
             }
 
             SATNonCNFMethod::~SATNonCNFMethod() {
@@ -20,32 +20,21 @@ namespace gsjj {
             }
 
             bool SATNonCNFMethod::solve() {
-                const std::string& in = getInputFile();
-                const std::string& out = getOutputFile();
-                std::ofstream output(in);
-                if (createFormula(output)) {
-                    output.close();
-                    m_triedSolve = true;
-                    const char* argv[] = {
-                        "./limboole",
-                        "-s",
-                        in.c_str(),
-                        "-o",
-                        out.c_str(),
-                    };
-
-                    if (mustStop && *mustStop) {
-                        return false;
-                    }
+                buildFormula();
+                m_triedSolve = true;
+
+                if (mustStop && *mustStop) {
+                    return false;
+                }
 
+                if (m_formula) {
                     m_cpuTimeStart = cpuTime();
-                    limboole(5, argv, mustStop);
+                    int result = limboole_sat(m_manager.get(), m_formula);
                     m_cpuTimeEnd = cpuTime();
 
-                    return m_hasSolution = isSatisfiable();
+                    return m_hasSolution = (result == 10);
                 }
                 else {
-                    output.close();
                     return m_hasSolution = (m_Sp.size() == 0 || m_Sm.size() == 0);
                 }
             }
@@ -65,10 +54,7 @@ namespace gsjj {
                         }
                         return dfa;
                     }
-                    std::ifstream file(getOutputFile());
-                    auto dfa = toDFA(file);
-                    file.close();
-                    return dfa;
+                    return toDFA();
                 }
                 return nullptr;
             }
@@ -77,25 +63,65 @@ namespace gsjj {
                 mustStop = stopPointer;
             }
 
-            bool SATNonCNFMethod::isSatisfiable() const {
-                std::ifstream file(getOutputFile());
-                std::string line;
-                std::getline(file, line);
-                if (line.find("UNSATISFIABLE") != std::string::npos) {
+            bool SATNonCNFMethod::writeFormula(const std::string &fileName) {
+                if (!m_manager) {
+                    buildFormula();
+                }
+                if (!m_formula) {
                     return false;
                 }
-                else {
-                    return true;
+
+                std::FILE *file = std::fopen(fileName.c_str(), "w");
+                if (!file) {
+                    return false;
+                }
+                limboole_write(m_manager.get(), m_formula, file);
+                return std::fclose(file) == 0;
+            }
+
+            void SATNonCNFMethod::buildFormula() {
+                m_manager.reset(limboole_new(mustStop));
+                m_formula = createFormula();
+            }
+
+            LimbooleNode *SATNonCNFMethod::newVariable() {
+                return limboole_variable(m_manager.get());
+            }
+
+            LimbooleNode *SATNonCNFMethod::newNot(LimbooleNode *a) {
+                return limboole_not(m_manager.get(), a);
+            }
+
+            LimbooleNode *SATNonCNFMethod::newAnd(LimbooleNode *a, LimbooleNode *b) {
+                if (!a) {
+                    return b;
+                }
+                else if (!b) {
+                    return a;
                 }
+                return limboole_and(m_manager.get(), a, b);
+            }
+
+            LimbooleNode *SATNonCNFMethod::newOr(LimbooleNode *a, LimbooleNode *b) {
+                if (!a) {
+                    return b;
+                }
+                else if (!b) {
+                    return a;
+                }
+                return limboole_or(m_manager.get(), a, b);
+            }
+
+            LimbooleNode *SATNonCNFMethod::newImplies(LimbooleNode *a, LimbooleNode *b) {
+                return limboole_implies(m_manager.get(), a, b);
             }
 
-            std::string SATNonCNFMethod::getInputFile() const {
-                // TODO: find a way for Windows
-                return "/tmp/" + getFileName() + std::to_string(m_numberStates);
+            LimbooleNode *SATNonCNFMethod::newIff(LimbooleNode *a, LimbooleNode *b) {
+                return limboole_iff(m_manager.get(), a, b);
             }
 
-            std::string SATNonCNFMethod::getOutputFile() const {
-                return getInputFile() + "-test";
+            bool SATNonCNFMethod::value(LimbooleNode *variable) const {
+                return limboole_value(m_manager.get(), variable) != 0;
             }
         }
     }
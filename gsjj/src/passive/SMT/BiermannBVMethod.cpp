@@ -0,0 +1,112 @@
+#include "gsjj/passive/SMT/BiermannBVMethod.h"
+#include "gsjj/passive/MethodFactory.h"
+
+using namespace CVC4;
+
+namespace gsjj {
+    namespace passive {
+        namespace SMT {
+            BiermannBVMethod::BiermannBVMethod(std::shared_ptr<const Sample> sample, unsigned int n) :
+                SMTMethod(sample, n),
+                m_width(0)
+            {
+                s_registered = s_registered;
+                LogicInfo logic("QF_BV");
+                m_SMTEngine.setLogic(logic);
+            }
+
+            BiermannBVMethod::~BiermannBVMethod() {
+
+            }
+
+            std::string BiermannBVMethod::getFactoryName() {
+                return "biermannBV";
+            }
+
+            bool BiermannBVMethod::incrementNumberOfStates() {
+                // The variables can not be widened
+                if (m_width != 0 && (1u << m_width) < m_numberStates + 1) {
+                    return false;
+                }
+                return SMTMethod::incrementNumberOfStates();
+            }
+
+            void BiermannBVMethod::createVariables() {
+                m_width = bitWidth(m_numberStates);
+                BitVectorType state = m_exprManager.mkBitVectorType(m_width);
+
+                m_stateName.clear();
+                m_stateName.reserve(m_prefixTree.size());
+                for (unsigned int u = 0 ; u < m_prefixTree.size() ; u++) {
+                    m_stateName.push_back(m_exprManager.mkVar("x_" + std::to_string(u), state));
+                }
+            }
+
+            CVC4::Expr BiermannBVMethod::createConstraints() {
+                // A bit-vector is never negative: there is no lower bound
+                Expr formula = m_exprManager.mkConst(true);
+
+                // Equation 4.2.1
+                // The implication is symmetric in u and v and always holds if u = v: we only need the pairs u < v (see computePrefixPairs)
+                for (const PrefixPair &pair : prefixPairs()) {
+                    const unsigned int u = pair.u;
+                    const unsigned int v = pair.v;
+                    Expr premise = m_exprManager.mkExpr(kind::EQUAL, m_stateName[u], m_stateName[v]);
+
+                    // If u and v are in conflict, they can not end in the same state
+                    if (!pair.compatible) {
+                        formula = formula.andExpr(premise.notExpr());
+                        continue;
+                    }
+
+                    for (const unsigned int &ua : m_prefixTree[u].children) {
+                        const unsigned int va = m_prefixTree.getChild(v, m_prefixTree[ua].symbol);
+                        if (va == PrefixTree::none) {
+                            continue;
+                        }
+
+                        Expr conclusion = m_exprManager.mkExpr(kind::EQUAL, m_stateName[ua], m_stateName[va]);
+
+                        formula = formula.andExpr(m_exprManager.mkExpr(kind::IMPLIES, premise, conclusion));
+                    }
+                }
+
+                // Equation 4.2.2
+                for (const auto &u : m_SpIds) {
+                    for (const auto &v : m_SmIds) {
+                        formula = formula.andExpr(m_exprManager.mkExpr(kind::EQUAL, m_stateName[u], m_stateName[v]).notExpr());
+                    }
+                }
+
+                return formula;
+            }
+
+            CVC4::Expr BiermannBVMethod::createBounds() {
+                Expr formula = m_exprManager.mkConst(true);
+
+                // If n is a power of two, every value of the bit-vectors is a state
+                if ((1u << m_width) == m_numberStates) {
+                    return formula;
+                }
+
+                // Values in [0, numberStates-1]
+                Expr n = m_exprManager.mkConst(BitVector(m_width, m_numberStates - 1));
+                for (unsigned int u = 0 ; u < m_prefixTree.size() ; u++) {
+                    formula = formula.andExpr(m_exprManager.mkExpr(kind::BITVECTOR_ULE, m_stateName[u], n));
+                }
+
+                return formula;
+            }
+
+            std::unique_ptr<DFA<char>> BiermannBVMethod::toDFA() {
+                // The state reached by each prefix
+                std::vector<unsigned int> states(m_prefixTree.size());
+                for (unsigned int u = 0 ; u < m_prefixTree.size() ; u++) {
+                    states[u] = bitVectorValue(m_stateName[u]);
+                }
+
+                return dfaFromStates(states);
+            }
+        }
+    }
+}
\ No newline at end of file
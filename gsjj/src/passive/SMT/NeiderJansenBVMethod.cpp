@@ -0,0 +1,141 @@
+#include "gsjj/passive/SMT/NeiderJansenBVMethod.h"
+
+using namespace CVC4;
+
+namespace gsjj {
+    namespace passive {
+        namespace SMT {
+            NeiderJansenBVMethod::NeiderJansenBVMethod(std::shared_ptr<const Sample> sample, unsigned int n) :
+                SMTMethod(sample, n),
+                m_width(0),
+                m_symbolWidth(0)
+            {
+                s_registered = s_registered;
+                LogicInfo logic("QF_UFBV");
+                m_SMTEngine.setLogic(logic);
+            }
+
+            NeiderJansenBVMethod::~NeiderJansenBVMethod() {
+
+            }
+
+            std::string NeiderJansenBVMethod::getFactoryName() {
+                return "neiderBV";
+            }
+
+            bool NeiderJansenBVMethod::incrementNumberOfStates() {
+                // The functions can not be widened
+                if (m_width != 0 && (1u << m_width) < m_numberStates + 1) {
+                    return false;
+                }
+                return SMTMethod::incrementNumberOfStates();
+            }
+
+            CVC4::Expr NeiderJansenBVMethod::state(unsigned int i) {
+                return m_exprManager.mkConst(BitVector(m_width, i));
+            }
+
+            CVC4::Expr NeiderJansenBVMethod::transition(const CVC4::Expr &i, unsigned int a) {
+                return m_exprManager.mkExpr(kind::APPLY_UF, d, i, m_exprManager.mkConst(BitVector(m_symbolWidth, a)));
+            }
+
+            void NeiderJansenBVMethod::createVariables() {
+                m_width = bitWidth(m_numberStates);
+                m_symbolWidth = bitWidth(m_symbols.size());
+                const unsigned int prefixWidth = bitWidth(m_prefixTree.size());
+
+                // Basic types
+                BitVectorType stateType = m_exprManager.mkBitVectorType(m_width);
+                BitVectorType symbolType = m_exprManager.mkBitVectorType(m_symbolWidth);
+                BitVectorType prefixType = m_exprManager.mkBitVectorType(prefixWidth);
+
+                // The functions
+                x = m_exprManager.mkVar("x", m_exprManager.mkFunctionType(prefixType, stateType));
+                f = m_exprManager.mkVar("f", m_exprManager.mkFunctionType(stateType, m_exprManager.booleanType()));
+                d = m_exprManager.mkVar("d", m_exprManager.mkFunctionType({stateType, symbolType}, stateType));
+
+                // x(u) for every prefix (its identifier, the empty word being 0)
+                m_xOfPrefix.clear();
+                m_xOfPrefix.reserve(m_prefixTree.size());
+                for (unsigned int u = 0 ; u < m_prefixTree.size() ; u++) {
+                    m_xOfPrefix.push_back(m_exprManager.mkExpr(kind::APPLY_UF, x, m_exprManager.mkConst(BitVector(prefixWidth, u))));
+                }
+            }
+
+            CVC4::Expr NeiderJansenBVMethod::createConstraints() {
+                std::vector<Expr> assumptions;
+                assumptions.reserve(m_prefixTree.size() + m_SpIds.size() + m_SmIds.size());
+
+                // Equation 4.6.3 : for all u_j = u_i a in Pref, x(j) = d(x(i), a)
+                for (unsigned int uj = 1 ; uj < m_prefixTree.size() ; uj++) {
+                    const unsigned int ui = m_prefixTree[uj].parent;
+                    Expr d_x_i_a = transition(m_xOfPrefix[ui], symbolIndex(m_prefixTree[uj].symbol));
+                    assumptions.push_back(m_exprManager.mkExpr(kind::EQUAL, m_xOfPrefix[uj], d_x_i_a));
+                }
+
+                // Equation 4.6.4
+                for (const auto &ui : m_SpIds) {
+                    assumptions.push_back(m_exprManager.mkExpr(kind::APPLY_UF, f, m_xOfPrefix[ui]));
+                }
+                for (const auto &ui : m_SmIds) {
+                    assumptions.push_back(m_exprManager.mkExpr(kind::APPLY_UF, f, m_xOfPrefix[ui]).notExpr());
+                }
+
+                return conjunction(assumptions);
+            }
+
+            CVC4::Expr NeiderJansenBVMethod::createBounds() {
+                std::vector<Expr> assumptions;
+
+                // If n is a power of two, every value of the bit-vectors is a state
+                if ((1u << m_width) == m_numberStates) {
+                    return conjunction(assumptions);
+                }
+
+                Expr last = state(m_numberStates - 1);
+
+                // Equation 4.6.1 : x(0) < n
+                assumptions.push_back(m_exprManager.mkExpr(kind::BITVECTOR_ULE, m_xOfPrefix[0], last));
+
+                // Equation 4.6.2 : for all i in Q, a in Sigma, d(i, a) < n
+                for (unsigned int i = 0 ; i < m_numberStates ; i++) {
+                    Expr i_expr = state(i);
+                    for (unsigned int a = 0 ; a < m_symbols.size() ; a++) {
+                        assumptions.push_back(m_exprManager.mkExpr(kind::BITVECTOR_ULE, transition(i_expr, a), last));
+                    }
+                }
+
+                return conjunction(assumptions);
+            }
+
+            std::unique_ptr<DFA<char>> NeiderJansenBVMethod::toDFA() {
+                // We start by searching the initial state
+                unsigned int initial = bitVectorValue(m_xOfPrefix[0]);
+
+                std::vector<bool> accepting(m_numberStates);
+                for (unsigned int i = 0 ; i < m_numberStates ; i++) {
+                    accepting[i] = m_SMTEngine.getValue(m_exprManager.mkExpr(kind::APPLY_UF, f, state(i))).getConst<bool>();
+                }
+
+                std::unique_ptr<DFA<char>> dfa = std::make_unique<DFA<char>>(initial, accepting[initial], m_numberStates, m_symbols.size());
+
+                // Now, we process the other states
+                for (unsigned int i = 0 ; i < m_numberStates ; i++) {
+                    if (i != initial) {
+                        dfa->addState(i, accepting[i]);
+                    }
+                }
+
+                // Finally, we create the transitions
+                for (unsigned int i = 0 ; i < m_numberStates ; i++) {
+                    Expr i_expr = state(i);
+                    for (unsigned int a = 0 ; a < m_symbols.size() ; a++) {
+                        dfa->addTransition(i, m_symbols[a], bitVectorValue(transition(i_expr, a)));
+                    }
+                }
+
+                return dfa;
+            }
+        }
+    }
+}
\ No newline at end of file
@@ -9,8 +9,8 @@ bool isAccepting(Expr f_value) {
 namespace gsjj {
     namespace passive {
         namespace SMT {
-            NeiderJansenMethod::NeiderJansenMethod(const std::set<std::string> &SpSet, const std::set<std::string> &SmSet, const std::set<std::string> &SSet, const std::set<std::string> &prefixesSet, const std::set<char> &alphabetSet, unsigned int n) :
-                SMTMethod(SpSet, SmSet, SSet, prefixesSet, alphabetSet, n)
+            NeiderJansenMethod::NeiderJansenMethod(std::shared_ptr<const Sample> sample, unsigned int n) :
+                SMTMethod(sample, n)
             {
                 s_registered = s_registered;
                 LogicInfo logic;
@@ -47,29 +47,31 @@ namespace gsjj {
                 f = m_exprManager.mkVar("f", intToInt);
                 d = m_exprManager.mkVar("d", intTimesIntToInt);
 
-                // Some constants
+                // Some constants (n is given by createBounds since it changes in incremental mode)
                 zero = m_exprManager.mkConst(Rational(0));
-                n = m_exprManager.mkConst(Rational(m_numberStates));
 
-                // We create a distinct constant for every prefix
-                unsigned int i = 0;
-                for (const auto &u : m_prefixes) {
-                    m_prefixToInt.emplace(u, m_exprManager.mkConst(Rational(i++)));
+                // Every prefix is a distinct constant (its identifier, the empty word being 0). x(u) is created once
+                m_xOfPrefix.clear();
+                m_xOfPrefix.reserve(m_prefixTree.size());
+                for (unsigned int u = 0 ; u < m_prefixTree.size() ; u++) {
+                    m_xOfPrefix.push_back(m_exprManager.mkExpr(kind::APPLY_UF, x, m_exprManager.mkConst(Rational(u))));
                 }
             }
 
-            CVC4::Expr NeiderJansenMethod::createConstraints() {
+            CVC4::Expr NeiderJansenMethod::createBounds() {
+                n = m_exprManager.mkConst(Rational(m_numberStates));
 
-                Expr x_0 = m_exprManager.mkExpr(kind::APPLY_UF, x, zero);
+                std::vector<Expr> assumptions;
+                assumptions.reserve(1 + m_numberStates * m_alphabet.size());
 
                 // Equation 4.6.1 : x(0) < n
-                Expr assumptions = m_exprManager.mkExpr(kind::LT, x_0, n);
+                assumptions.push_back(m_exprManager.mkExpr(kind::LT, m_xOfPrefix[0], n));
 
                 // Equation 4.6.2 : for all i in Q, a in Sigma, d(i, a) < n
                 for (unsigned int i = 0 ; i < m_numberStates ; i++) {
                     for (const char &a : m_alphabet) {
                         Expr i_a = m_exprManager.mkExpr(kind::APPLY_CONSTRUCTOR, intTimesIntConstructor, m_exprManager.mkConst(Rational(i)), m_exprManager.mkConst(Rational(a)));
-                        assumptions = assumptions.andExpr(
+                        assumptions.push_back(
                             m_exprManager.mkExpr(
                                 kind::LT,
                                 m_exprManager.mkExpr(
@@ -83,56 +85,52 @@ namespace gsjj {
                     }
                 }
 
+                return conjunction(assumptions);
+            }
+
+            CVC4::Expr NeiderJansenMethod::createConstraints() {
+                std::vector<Expr> assumptions;
+                assumptions.reserve(2 * m_prefixTree.size() + m_SpIds.size() + m_SmIds.size());
+
                 // Equation 4.6.3 : for all u_i, u_j in Pref, for all a in Sigma such that u_j = u_i a, x(j) = d(x(i), a)
-                for (const auto &ui : m_prefixes) {
-                    for (const auto &uj : m_prefixes) {
-                        // We need that u_j = u_i
-                        if (uj.size() > 0 && uj.substr(0, uj.size() - 1) == ui) {
-                            Expr a = m_exprManager.mkConst(Rational(uj.at(uj.size() - 1)));
-                            Expr i = m_prefixToInt[ui];
-                            Expr j = m_prefixToInt[uj];
-
-                            Expr x_j = m_exprManager.mkExpr(kind::APPLY_UF, x, j);
-                            Expr x_i = m_exprManager.mkExpr(kind::APPLY_UF, x, i);
-                            Expr x_i_a = m_exprManager.mkExpr(kind::APPLY_CONSTRUCTOR, intTimesIntConstructor, x_i, a);
-                            
-                            assumptions = assumptions.andExpr(
-                                m_exprManager.mkExpr(kind::EQUAL,
-                                    x_j,
-                                    m_exprManager.mkExpr(kind::APPLY_UF, d, x_i_a)
-                                )
-                            );
-                        }
-                    }
+                // u_i is the parent of u_j in the prefix tree
+                for (unsigned int uj = 1 ; uj < m_prefixTree.size() ; uj++) {
+                    Expr a = m_exprManager.mkConst(Rational(m_prefixTree[uj].symbol));
+                    const Expr &x_i = m_xOfPrefix[m_prefixTree[uj].parent];
+                    Expr x_i_a = m_exprManager.mkExpr(kind::APPLY_CONSTRUCTOR, intTimesIntConstructor, x_i, a);
+
+                    assumptions.push_back(
+                        m_exprManager.mkExpr(kind::EQUAL,
+                            m_xOfPrefix[uj],
+                            m_exprManager.mkExpr(kind::APPLY_UF, d, x_i_a)
+                        )
+                    );
                 }
 
                 // Equation 4.6.4
-                for (const auto &ui : m_Sp) {
-                    Expr x_i = m_exprManager.mkExpr(kind::APPLY_UF, x, m_prefixToInt[ui]);
-                    Expr f_x_i = m_exprManager.mkExpr(kind::APPLY_UF, f, x_i);
-                    assumptions = assumptions.andExpr(m_exprManager.mkExpr(kind::DISTINCT, f_x_i, zero));
+                for (const auto &ui : m_SpIds) {
+                    Expr f_x_i = m_exprManager.mkExpr(kind::APPLY_UF, f, m_xOfPrefix[ui]);
+                    assumptions.push_back(m_exprManager.mkExpr(kind::DISTINCT, f_x_i, zero));
                 }
-                for (const auto &ui : m_Sm) {
-                    Expr x_i = m_exprManager.mkExpr(kind::APPLY_UF, x, m_prefixToInt[ui]);
-                    Expr f_x_i = m_exprManager.mkExpr(kind::APPLY_UF, f, x_i);
-                    assumptions = assumptions.andExpr(m_exprManager.mkExpr(kind::EQUAL, f_x_i, zero));
+                for (const auto &ui : m_SmIds) {
+                    Expr f_x_i = m_exprManager.mkExpr(kind::APPLY_UF, f, m_xOfPrefix[ui]);
+                    assumptions.push_back(m_exprManager.mkExpr(kind::EQUAL, f_x_i, zero));
                 }
 
                 // Finally, we must have that x(i) >= 0 (because it's a N -> N function)
-                for (const auto &ui : m_prefixes) {
-                    Expr x_i = m_exprManager.mkExpr(kind::APPLY_UF, x, m_prefixToInt[ui]);
-                    assumptions = assumptions.andExpr(m_exprManager.mkExpr(kind::GEQ, x_i, zero));
+                for (unsigned int ui = 0 ; ui < m_prefixTree.size() ; ui++) {
+                    assumptions.push_back(m_exprManager.mkExpr(kind::GEQ, m_xOfPrefix[ui], zero));
                 }
 
-                return assumptions;
+                return conjunction(assumptions);
             }
 
             std::unique_ptr<DFA<char>> NeiderJansenMethod::toDFA() {
                 // We start by searching the initial state
-                Expr x_0 = m_exprManager.mkExpr(kind::APPLY_UF, x, zero);
+                const Expr &x_0 = m_xOfPrefix[0];
                 unsigned int initial = m_SMTEngine.getValue(x_0).getConst<Rational>().getNumerator().toUnsignedInt();
 
-                std::unique_ptr<DFA<char>> dfa = std::make_unique<DFA<char>>(initial, isAccepting(m_SMTEngine.getValue(m_exprManager.mkExpr(kind::APPLY_UF, f, x_0))));
+                std::unique_ptr<DFA<char>> dfa = std::make_unique<DFA<char>>(initial, isAccepting(m_SMTEngine.getValue(m_exprManager.mkExpr(kind::APPLY_UF, f, x_0))), m_numberStates, m_alphabet.size());
 
                 // Now, we process the other states
                 for (unsigned int i = 0 ; i < m_numberStates ; i++) {
@@ -5,10 +5,13 @@
 namespace gsjj {
     namespace passive {
         namespace SMT {
-            SMTMethod::SMTMethod(const std::set<std::string> &SpSet, const std::set<std::string> &SmSet, const std::set<std::string> &SSet, const std::set<std::string> &prefixesSet, const std::set<char> &alphabetSet, unsigned int n) :
-                Method(SpSet, SmSet, SSet, prefixesSet, alphabetSet, n),
+            SMTMethod::SMTMethod(std::shared_ptr<const Sample> sample, unsigned int n) :
+                Method(sample, n),
                 m_exprManager(),
-                m_SMTEngine(&m_exprManager)
+                m_SMTEngine(&m_exprManager),
+                m_incremental(false),
+                m_encoded(false),
+                m_pushed(false)
             {
                 // To enable the .getValue() function
                 m_SMTEngine.setOption("produce-models", true);
@@ -19,12 +22,35 @@ namespace gsjj {
             }
 
             bool SMTMethod::solve() {
-                createVariables();
-                CVC4::Expr expr = createConstraints();
+                if (!m_incremental) {
+                    createVariables();
+                    CVC4::Expr expr = createConstraints().andExpr(createBounds());
+
+                    m_triedSolve = true;
+                    m_cpuTimeStart = Minisat::cpuTime();
+                    CVC4::Result result = m_SMTEngine.checkSat(expr);
+                    m_cpuTimeEnd = Minisat::cpuTime();
+                    m_hasSolution = result.isSat();
+                    return m_hasSolution;
+                }
+
+                // In incremental mode, the variables and the constraints are kept between the calls
+                if (!m_encoded) {
+                    createVariables();
+                    m_SMTEngine.assertFormula(createConstraints());
+                    m_encoded = true;
+                }
+                // The bounds of a previous call to solve() for the same number of states are replaced
+                if (m_pushed) {
+                    m_SMTEngine.pop();
+                }
+                m_SMTEngine.push();
+                m_pushed = true;
+                m_SMTEngine.assertFormula(createBounds());
 
                 m_triedSolve = true;
                 m_cpuTimeStart = Minisat::cpuTime();
-                CVC4::Result result = m_SMTEngine.checkSat(expr);
+                CVC4::Result result = m_SMTEngine.checkSat();
                 m_cpuTimeEnd = Minisat::cpuTime();
                 m_hasSolution = result.isSat();
                 return m_hasSolution;
@@ -44,6 +70,59 @@ namespace gsjj {
                 m_SMTEngine.setTimeLimit(std::chrono::milliseconds(timeLimit).count(), false);
                 m_SMTEngine.setTimeLimit(std::chrono::milliseconds(timeLimit).count(), true);
             }
+
+            void SMTMethod::interrupt() {
+                m_SMTEngine.interrupt();
+            }
+
+            unsigned int SMTMethod::bitWidth(unsigned int numberValues) {
+                unsigned int width = 1;
+                while ((1u << width) < numberValues) {
+                    width++;
+                }
+                return width;
+            }
+
+            CVC4::Expr SMTMethod::conjunction(const std::vector<CVC4::Expr> &expressions) {
+                // CVC4 needs at least two children for an AND
+                if (expressions.empty()) {
+                    return m_exprManager.mkConst(true);
+                }
+                else if (expressions.size() == 1) {
+                    return expressions[0];
+                }
+                return m_exprManager.mkExpr(CVC4::kind::AND, expressions);
+            }
+
+            unsigned int SMTMethod::bitVectorValue(const CVC4::Expr &expr) {
+                return m_SMTEngine.getValue(expr).getConst<CVC4::BitVector>().getValue().toUnsignedInt();
+            }
+
+            bool SMTMethod::enableIncrementalMode() {
+                // CVC4 only accepts the option before the first assertion
+                if (m_triedSolve) {
+                    return false;
+                }
+                m_SMTEngine.setOption("incremental", true);
+                m_incremental = true;
+                return true;
+            }
+
+            bool SMTMethod::incrementNumberOfStates() {
+                if (!m_incremental) {
+                    return false;
+                }
+
+                // The bounds for the previous number of states are removed. The model is lost
+                if (m_pushed) {
+                    m_SMTEngine.pop();
+                    m_pushed = false;
+                }
+                m_numberStates++;
+                m_triedSolve = false;
+                m_hasSolution = false;
+                return true;
+            }
         }
     }
 }
\ No newline at end of file
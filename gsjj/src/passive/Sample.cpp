@@ -0,0 +1,72 @@
+#include <utility>
+
+#include "gsjj/passive/Sample.h"
+
+namespace gsjj {
+    namespace passive {
+        Sample::Sample(std::set<std::string> Sp, std::set<std::string> Sm) :
+            m_Sp(std::move(Sp)),
+            m_Sm(std::move(Sm)),
+            m_prefixTree(m_Sp, m_Sm),
+            m_symbols(m_prefixTree.getAlphabet().begin(), m_prefixTree.getAlphabet().end())
+        {
+            for (unsigned int u = 0 ; u < m_prefixTree.size() ; u++) {
+                if (m_prefixTree[u].label == PrefixTree::Label::Accept) {
+                    m_SpIds.push_back(u);
+                }
+                else if (m_prefixTree[u].label == PrefixTree::Label::Reject) {
+                    m_SmIds.push_back(u);
+                }
+            }
+
+            m_symbolIndex.fill(0);
+            for (unsigned int a = 0 ; a < m_symbols.size() ; a++) {
+                m_symbolIndex[static_cast<unsigned char>(m_symbols[a])] = a;
+            }
+        }
+
+        const std::set<std::string> &Sample::getSp() const {
+            return m_Sp;
+        }
+
+        const std::set<std::string> &Sample::getSm() const {
+            return m_Sm;
+        }
+
+        const std::set<char> &Sample::getAlphabet() const {
+            return m_prefixTree.getAlphabet();
+        }
+
+        const PrefixTree &Sample::getPrefixTree() const {
+            return m_prefixTree;
+        }
+
+        const std::vector<unsigned int> &Sample::getSpIds() const {
+            return m_SpIds;
+        }
+
+        const std::vector<unsigned int> &Sample::getSmIds() const {
+            return m_SmIds;
+        }
+
+        const std::vector<char> &Sample::getSymbols() const {
+            return m_symbols;
+        }
+
+        const std::vector<PrefixPair> &Sample::getPrefixPairs() const {
+            std::call_once(m_prefixPairsFlag, [this]() {
+                m_prefixPairs = computePrefixPairs(m_prefixTree);
+            });
+            return m_prefixPairs;
+        }
+
+        const std::vector<std::string> &Sample::getConflictClique() const {
+            std::call_once(m_cliqueFlag, [this]() {
+                for (const auto &id : computeConflictClique(m_prefixTree)) {
+                    m_clique.push_back(m_prefixTree.getPrefix(id));
+                }
+            });
+            return m_clique;
+        }
+    }
+}
\ No newline at end of file
@@ -0,0 +1,158 @@
+/**
+ * \file SearchStrategy.cpp
+ *
+ * This file implements the strategies used to seek the minimal number of states.
+ */
+
+#include "gsjj/passive/SearchStrategy.h"
+
+#include <algorithm>
+#include <stdexcept>
+
+namespace gsjj {
+    namespace passive {
+        SearchStrategy::SearchStrategy() :
+            m_lowerBound(1),
+            m_initialLowerBound(1),
+            m_upperBound(0),
+            m_trivialUpperBound(1)
+        {
+        }
+
+        SearchStrategy::~SearchStrategy() {
+
+        }
+
+        void SearchStrategy::start(unsigned int trivialUpperBound, unsigned int lowerBound) {
+            m_lowerBound = std::max(1u, lowerBound);
+            m_initialLowerBound = m_lowerBound;
+            m_upperBound = 0;
+            m_trivialUpperBound = std::max(m_lowerBound, trivialUpperBound);
+            m_probes.clear();
+        }
+
+        unsigned int SearchStrategy::nextNumberOfStates() {
+            if (isFinished()) {
+                return 0;
+            }
+            return choose();
+        }
+
+        void SearchStrategy::report(unsigned int n, bool satisfiable, double time, unsigned int usedStates) {
+            m_probes.push_back({n, satisfiable, time});
+
+            if (satisfiable) {
+                if (!hasUpperBound() || n < m_upperBound) {
+                    m_upperBound = n;
+                }
+            }
+            else {
+                m_lowerBound = std::max(m_lowerBound, n + 1);
+            }
+
+            onReport(n, satisfiable, usedStates);
+        }
+
+        bool SearchStrategy::isFinished() const {
+            return hasUpperBound() && m_lowerBound >= m_upperBound;
+        }
+
+        unsigned int SearchStrategy::getLowerBound() const {
+            return m_lowerBound;
+        }
+
+        unsigned int SearchStrategy::getUpperBound() const {
+            return m_upperBound;
+        }
+
+        const std::vector<SearchStrategy::Probe> &SearchStrategy::getProbes() const {
+            return m_probes;
+        }
+
+        void SearchStrategy::onReport(unsigned int /*n*/, bool /*satisfiable*/, unsigned int /*usedStates*/) {
+
+        }
+
+        bool SearchStrategy::hasUpperBound() const {
+            return m_upperBound != 0;
+        }
+
+        unsigned int LinearSearch::choose() const {
+            return m_lowerBound;
+        }
+
+        unsigned int ExponentialBinarySearch::choose() const {
+            if (!hasUpperBound()) {
+                // b, b + 1, b + 3, b + 7, ... (1, 2, 4, 8, ... if b = 1)
+                return std::max(m_lowerBound, 2 * m_lowerBound - m_initialLowerBound - 1);
+            }
+            else {
+                // The middle of [lower, upper)
+                return m_lowerBound + (m_upperBound - m_lowerBound) / 2;
+            }
+        }
+
+        DescendingSearch::DescendingSearch(unsigned int upperBound) :
+            m_start(upperBound)
+        {
+        }
+
+        unsigned int DescendingSearch::choose() const {
+            if (!hasUpperBound()) {
+                return std::max(m_lowerBound, m_start == 0 ? m_trivialUpperBound : m_start);
+            }
+            else {
+                return m_upperBound - 1;
+            }
+        }
+
+        SatFirstSearch::SatFirstSearch(unsigned int upperBound) :
+            m_start(upperBound),
+            m_bestUsed(0)
+        {
+        }
+
+        unsigned int SatFirstSearch::choose() const {
+            if (!hasUpperBound()) {
+                return std::max(m_lowerBound, m_start == 0 ? m_trivialUpperBound : m_start);
+            }
+            // Every n between the number of reachable states of the best DFA and the upper bound is satisfiable
+            // We can therefore directly try right below
+            else if (m_bestUsed > m_lowerBound) {
+                return m_bestUsed - 1;
+            }
+            else {
+                // The best DFA has an optimal number of reachable states, we just need the method with this number of states
+                return m_bestUsed;
+            }
+        }
+
+        void SatFirstSearch::onReport(unsigned int n, bool satisfiable, unsigned int usedStates) {
+            if (satisfiable) {
+                // usedStates can not be greater than n. If it's 0, we don't know the number of reachable states
+                unsigned int used = (usedStates == 0) ? n : std::min(usedStates, n);
+                if (m_bestUsed == 0 || used < m_bestUsed) {
+                    m_bestUsed = used;
+                }
+            }
+        }
+
+        std::unique_ptr<SearchStrategy> constructSearchStrategy(const std::string &name, unsigned int upperBound) {
+            if (name == "linear") {
+                return std::make_unique<LinearSearch>();
+            }
+            else if (name == "exponential") {
+                return std::make_unique<ExponentialBinarySearch>();
+            }
+            else if (name == "descending") {
+                return std::make_unique<DescendingSearch>(upperBound);
+            }
+            else if (name == "satFirst") {
+                return std::make_unique<SatFirstSearch>(upperBound);
+            }
+            else {
+                throw std::invalid_argument("Unknown search strategy: " + name);
+            }
+        }
+    }
+}
@@ -0,0 +1,146 @@
+#include <algorithm>
+#include <iterator>
+#include <thread>
+
+#include "gsjj/passive/Verification.h"
+
+namespace gsjj {
+    namespace passive {
+        namespace {
+            /**
+             * The identifiers of the misclassified nodes
+             */
+            struct MisclassifiedIds {
+                std::vector<unsigned int> rejected;
+                std::vector<unsigned int> accepted;
+            };
+
+            /**
+             * The DFA restricted to the alphabet of the sample, in a dense table.
+             *
+             * The state 0 is a rejecting sink that replaces the missing transitions and the state p of the DFA is p + 1. Therefore, the nodes do not need any special case.
+             */
+            struct Table {
+                Table(const DFA<char> &dfa, const Sample &sample) :
+                    numberSymbols(sample.getSymbols().size()),
+                    delta((dfa.getTransitions().size() + 1) * numberSymbols, 0),
+                    accepting(dfa.getTransitions().size() + 1, false)
+                {
+                    for (unsigned int p : dfa.getStates()) {
+                        accepting[p + 1] = dfa.isAcceptingState(p);
+                        for (const auto &transition : dfa.getTransitions(p)) {
+                            if (sample.getAlphabet().count(transition.first) != 0) {
+                                delta[(p + 1) * numberSymbols + sample.symbolIndex(transition.first)] = transition.second + 1;
+                            }
+                        }
+                    }
+                }
+
+                const std::size_t numberSymbols;
+                std::vector<unsigned int> delta;
+                std::vector<bool> accepting;
+            };
+
+            /**
+             * Computes the states reached by the nodes in [first, last) from the states of their parents, and checks their labels
+             * @param states The state of the table reached by each node
+             */
+            void verifyNodes(const Table &table, const Sample &sample, unsigned int first, unsigned int last, std::vector<unsigned int> &states, MisclassifiedIds &misclassified) {
+                const PrefixTree &tree = sample.getPrefixTree();
+                for (unsigned int u = first ; u < last ; u++) {
+                    const auto &node = tree[u];
+                    const unsigned int state = table.delta[states[node.parent] * table.numberSymbols + sample.symbolIndex(node.symbol)];
+                    states[u] = state;
+
+                    const bool accepted = table.accepting[state];
+                    if (node.label == PrefixTree::Label::Accept && !accepted) {
+                        misclassified.rejected.push_back(u);
+                    }
+                    else if (node.label == PrefixTree::Label::Reject && accepted) {
+                        misclassified.accepted.push_back(u);
+                    }
+                }
+            }
+
+            std::vector<std::string> toWords(const std::vector<unsigned int> &ids, const PrefixTree &tree) {
+                std::vector<std::string> words;
+                words.reserve(ids.size());
+                for (unsigned int id : ids) {
+                    words.push_back(tree.getPrefix(id));
+                }
+                return words;
+            }
+        }
+
+        Misclassified verify(const DFA<char> &dfa, const Sample &sample, unsigned int numberThreads) {
+            if (numberThreads == 0) {
+                numberThreads = std::max(1u, std::thread::hardware_concurrency());
+            }
+
+            const PrefixTree &tree = sample.getPrefixTree();
+            const unsigned int size = tree.size();
+            std::vector<unsigned int> states(size);
+            MisclassifiedIds misclassified;
+
+            const Table table(dfa, sample);
+            states[0] = dfa.getInitialState() + 1;
+            if (tree[0].label == PrefixTree::Label::Accept && !table.accepting[states[0]]) {
+                misclassified.rejected.push_back(0);
+            }
+            else if (tree[0].label == PrefixTree::Label::Reject && table.accepting[states[0]]) {
+                misclassified.accepted.push_back(0);
+            }
+
+            // The nodes are numbered level by level, and the parents of a level are in the previous one. The nodes of a level are split in consecutive parts (consecutive subtrees) which are verified at the same time
+            for (unsigned int first = 1 ; first < size ; ) {
+                const unsigned int depth = tree[first].depth;
+                unsigned int last = first + 1;
+                for (unsigned int step = 1 ; last < size && tree[last].depth == depth ; step *= 2) {
+                    last = std::min(size, last + step);
+                    if (last < size && tree[last].depth != depth) {
+                        // The end of the level is between last - step and last
+                        unsigned int low = last - step, high = last;
+                        while (high - low > 1) {
+                            unsigned int middle = low + (high - low) / 2;
+                            (tree[middle].depth == depth ? low : high) = middle;
+                        }
+                        last = high;
+                        break;
+                    }
+                }
+
+                // Below a few thousand nodes per thread, starting the threads costs more than it saves
+                const unsigned int numberParts = std::max(1u, std::min(numberThreads, (last - first) / 4096));
+                if (numberParts == 1) {
+                    verifyNodes(table, sample, first, last, states, misclassified);
+                }
+                else {
+                    std::vector<MisclassifiedIds> parts(numberParts);
+                    std::vector<std::thread> threads;
+                    for (unsigned int t = 0 ; t < numberParts ; t++) {
+                        const unsigned int begin = first + static_cast<unsigned long long>(last - first) * t / numberParts;
+                        const unsigned int end = first + static_cast<unsigned long long>(last - first) * (t + 1) / numberParts;
+                        threads.emplace_back([&table, &sample, &states, &parts, t, begin, end]() {
+                            verifyNodes(table, sample, begin, end, states, parts[t]);
+                        });
+                    }
+                    for (auto &thread : threads) {
+                        thread.join();
+                    }
+                    // The parts are in increasing order, so the identifiers stay sorted
+                    for (const auto &part : parts) {
+                        misclassified.rejected.insert(misclassified.rejected.end(), part.rejected.begin(), part.rejected.end());
+                        misclassified.accepted.insert(misclassified.accepted.end(), part.accepted.begin(), part.accepted.end());
+                    }
+                }
+
+                first = last;
+            }
+
+            Misclassified result;
+            result.rejected = toWords(misclassified.rejected, tree);
+            result.accepted = toWords(misclassified.accepted, tree);
+            return result;
+        }
+    }
+}
\ No newline at end of file
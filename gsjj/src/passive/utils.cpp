@@ -1,8 +1,12 @@
 #include "gsjj/passive/utils.h"
 
 #include <algorithm>
+#include <iterator>
 #include <fstream>
+#include <limits>
 #include <random>
+#include <stdexcept>
+#include <tuple>
 
 #include "MapleCOMSPS_LRB/utils/System.h"
 
@@ -34,6 +38,231 @@ namespace gsjj {
             return alphabet;
         }
 
+        /**
+         * Tests whether there is a word uw in words such that vw is in others
+         */
+        static bool hasConflictingSuffix(const std::string &u, const std::string &v, const std::set<std::string> &words, const std::set<std::string> &others) {
+            // The words starting with u are consecutive in the set
+            std::string vw = v;
+            for (auto itr = words.lower_bound(u) ; itr != words.end() && itr->compare(0, u.size(), u) == 0 ; ++itr) {
+                vw.replace(v.size(), std::string::npos, *itr, u.size(), std::string::npos);
+                if (others.find(vw) != others.end()) {
+                    return true;
+                }
+            }
+            return false;
+        }
+
+        bool areInConflict(const std::string &u, const std::string &v, const std::set<std::string> &Sp, const std::set<std::string> &Sm) {
+            // We go through the words below the longest prefix (usually, there are less of them)
+            if (u.size() < v.size()) {
+                return areInConflict(v, u, Sp, Sm);
+            }
+            return hasConflictingSuffix(u, v, Sp, Sm) || hasConflictingSuffix(u, v, Sm, Sp);
+        }
+
+        const unsigned int PrefixTree::none = std::numeric_limits<unsigned int>::max();
+
+        PrefixTree::PrefixTree(const std::set<std::string> &Sp, const std::set<std::string> &Sm) {
+            // First, the nodes are created in the order of the words
+            std::vector<Node> nodes;
+            nodes.push_back({none, '\0', Label::Unknown, 0, {}});
+
+            auto insert = [&](const std::string &word, Label label) {
+                unsigned int current = 0;
+                for (const char &a : word) {
+                    auto &children = nodes[current].children;
+                    auto child = std::find_if(children.begin(), children.end(), [&](unsigned int c) {
+                        return nodes[c].symbol == a;
+                    });
+                    if (child == children.end()) {
+                        unsigned int id = nodes.size();
+                        nodes[current].children.push_back(id);
+                        nodes.push_back({current, a, Label::Unknown, nodes[current].depth + 1, {}});
+                        current = id;
+                    }
+                    else {
+                        current = *child;
+                    }
+                    m_alphabet.insert(a);
+                }
+                if (nodes[current].label != Label::Unknown && nodes[current].label != label) {
+                    throw std::invalid_argument("The word \"" + word + "\" is in both S+ and S-");
+                }
+                nodes[current].label = label;
+            };
+
+            for (const auto &word : Sp) {
+                insert(word, Label::Accept);
+            }
+            for (const auto &word : Sm) {
+                insert(word, Label::Reject);
+            }
+
+            // Then, the nodes are renumbered in breadth-first order
+            std::vector<unsigned int> order;
+            order.reserve(nodes.size());
+            std::vector<unsigned int> newId(nodes.size());
+            order.push_back(0);
+            for (std::size_t i = 0 ; i < order.size() ; i++) {
+                auto &children = nodes[order[i]].children;
+                std::sort(children.begin(), children.end(), [&](unsigned int a, unsigned int b) {
+                    return nodes[a].symbol < nodes[b].symbol;
+                });
+                newId[order[i]] = i;
+                order.insert(order.end(), children.begin(), children.end());
+            }
+
+            m_nodes.reserve(nodes.size());
+            for (const unsigned int &old : order) {
+                Node node = std::move(nodes[old]);
+                if (node.parent != none) {
+                    node.parent = newId[node.parent];
+                }
+                for (auto &child : node.children) {
+                    child = newId[child];
+                }
+                m_nodes.push_back(std::move(node));
+            }
+        }
+
+        std::size_t PrefixTree::size() const {
+            return m_nodes.size();
+        }
+
+        const PrefixTree::Node &PrefixTree::operator[](unsigned int id) const {
+            return m_nodes[id];
+        }
+
+        unsigned int PrefixTree::getChild(unsigned int id, char symbol) const {
+            for (const auto &child : m_nodes[id].children) {
+                if (m_nodes[child].symbol == symbol) {
+                    return child;
+                }
+            }
+            return none;
+        }
+
+        unsigned int PrefixTree::find(const std::string &prefix) const {
+            unsigned int current = 0;
+            for (auto itr = prefix.begin() ; itr != prefix.end() && current != none ; ++itr) {
+                current = getChild(current, *itr);
+            }
+            return current;
+        }
+
+        std::string PrefixTree::getPrefix(unsigned int id) const {
+            std::string prefix(m_nodes[id].depth, '\0');
+            for (unsigned int current = id ; current != 0 ; current = m_nodes[current].parent) {
+                prefix[m_nodes[current].depth - 1] = m_nodes[current].symbol;
+            }
+            return prefix;
+        }
+
+        const std::set<char> &PrefixTree::getAlphabet() const {
+            return m_alphabet;
+        }
+
+        bool PrefixTree::areInConflict(unsigned int u, unsigned int v) const {
+            // uw and vw are walked together, for every w that is possible from both u and v
+            std::vector<std::pair<unsigned int, unsigned int>> toVisit;
+            toVisit.emplace_back(u, v);
+            while (!toVisit.empty()) {
+                unsigned int a, b;
+                std::tie(a, b) = toVisit.back();
+                toVisit.pop_back();
+
+                // Under a single node, both words are always the same
+                if (a == b) {
+                    continue;
+                }
+
+                const Node &nodeA = m_nodes[a], &nodeB = m_nodes[b];
+                if (nodeA.label != Label::Unknown && nodeB.label != Label::Unknown && nodeA.label != nodeB.label) {
+                    return true;
+                }
+
+                // The children are sorted by symbol
+                auto itrA = nodeA.children.begin(), itrB = nodeB.children.begin();
+                while (itrA != nodeA.children.end() && itrB != nodeB.children.end()) {
+                    char symbolA = m_nodes[*itrA].symbol, symbolB = m_nodes[*itrB].symbol;
+                    if (symbolA < symbolB) {
+                        ++itrA;
+                    }
+                    else if (symbolB < symbolA) {
+                        ++itrB;
+                    }
+                    else {
+                        toVisit.emplace_back(*itrA, *itrB);
+                        ++itrA;
+                        ++itrB;
+                    }
+                }
+            }
+            return false;
+        }
+
+        std::vector<unsigned int> computeConflictClique(const PrefixTree &tree) {
+            // The identifiers are in breadth-first order
+            std::vector<unsigned int> clique;
+            for (unsigned int candidate = 0 ; candidate < tree.size() ; candidate++) {
+                bool inConflictWithAll = std::all_of(clique.begin(), clique.end(), [&](unsigned int member) {
+                    return tree.areInConflict(candidate, member);
+                });
+                if (inConflictWithAll) {
+                    clique.push_back(candidate);
+                }
+            }
+            return clique;
+        }
+
+        std::vector<PrefixPair> computePrefixPairs(const PrefixTree &tree) {
+            // Only the prefixes with at least one child can be in a pair
+            std::vector<unsigned int> internal;
+            for (unsigned int u = 0 ; u < tree.size() ; u++) {
+                if (!tree[u].children.empty()) {
+                    internal.push_back(u);
+                }
+            }
+
+            std::vector<PrefixPair> pairs;
+            for (auto itrU = internal.begin() ; itrU != internal.end() ; ++itrU) {
+                const auto &childrenU = tree[*itrU].children;
+                for (auto itrV = std::next(itrU) ; itrV != internal.end() ; ++itrV) {
+                    const auto &childrenV = tree[*itrV].children;
+                    // The children are sorted by symbol
+                    bool sharedSymbol = false;
+                    auto childU = childrenU.begin(), childV = childrenV.begin();
+                    while (!sharedSymbol && childU != childrenU.end() && childV != childrenV.end()) {
+                        char symbolU = tree[*childU].symbol, symbolV = tree[*childV].symbol;
+                        if (symbolU < symbolV) {
+                            ++childU;
+                        }
+                        else if (symbolV < symbolU) {
+                            ++childV;
+                        }
+                        else {
+                            sharedSymbol = true;
+                        }
+                    }
+
+                    if (sharedSymbol) {
+                        pairs.push_back({*itrU, *itrV, !tree.areInConflict(*itrU, *itrV)});
+                    }
+                }
+            }
+            return pairs;
+        }
+
+        std::vector<std::string> computeConflictClique(const std::set<std::string> &Sp, const std::set<std::string> &Sm) {
+            PrefixTree tree(Sp, Sm);
+            std::vector<std::string> clique;
+            for (const auto &id : computeConflictClique(tree)) {
+                clique.push_back(tree.getPrefix(id));
+            }
+            return clique;
+        }
+
         void readFromFile(const std::string &inputFile, std::set<std::string> &Sp, std::set<std::string> &Sm) {
             std::ifstream in(inputFile);
             std::string s;
@@ -7,10 +7,14 @@ make
 
 methods=(\
     "biermann"\
+    "biermannBV"\
     "neider"\
+    "neiderBV"\
     "unary"\
     "binary"\
+    "binaryDirect"\
     "heule"\
+    "heuleBFS"\
     "unaryNonCNF"\
     "binaryNonCNF"\
     "heuleNonCNF"\
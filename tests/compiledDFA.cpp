@@ -0,0 +1,207 @@
+#include "catch.hpp"
+
+#include <cstdio>
+#include <fstream>
+#include <list>
+#include <random>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "gsjj/DFA.h"
+#include "gsjj/CompiledDFA.h"
+
+using namespace gsjj;
+
+namespace {
+    // Accepts the words over {a, b} whose number of a is a multiple of n. The symbol c is not defined in the state n - 1
+    DFA<char> countingDFA(unsigned int n) {
+        DFA<char> dfa(0, true);
+        for (unsigned int i = 1 ; i < n ; i++) {
+            dfa.addState(i);
+        }
+        for (unsigned int i = 0 ; i < n ; i++) {
+            dfa.addTransition(i, 'a', (i + 1) % n);
+            dfa.addTransition(i, 'b', i);
+            if (i + 1 != n) {
+                dfa.addTransition(i, 'c', i);
+            }
+        }
+        return dfa;
+    }
+
+    std::vector<std::string> randomWords(std::size_t numberWords, unsigned int maxLength, const std::string &alphabet) {
+        std::mt19937 generator(42);
+        std::uniform_int_distribution<unsigned int> length(0, maxLength);
+        std::uniform_int_distribution<std::size_t> symbol(0, alphabet.size() - 1);
+        std::vector<std::string> words(numberWords);
+        for (auto &word : words) {
+            unsigned int l = length(generator);
+            for (unsigned int i = 0 ; i < l ; i++) {
+                word.push_back(alphabet[symbol(generator)]);
+            }
+        }
+        return words;
+    }
+}
+
+TEST_CASE("The list and vector words are read in the same way", "[DFA]") {
+    DFA<char> dfa = countingDFA(3);
+    for (const auto &word : randomWords(500, 10, "abcd")) {
+        REQUIRE(dfa.isAccepted(std::list<char>(word.begin(), word.end())) == dfa.isAccepted(std::vector<char>(word.begin(), word.end())));
+    }
+    REQUIRE(dfa.isAccepted(std::vector<char>({'a', 'b', 'a', 'a'})));
+    REQUIRE_FALSE(dfa.isAccepted(std::vector<char>({'a', 'b', 'a'})));
+}
+
+TEST_CASE("The transitions are stored by state and sorted by symbol", "[DFA]") {
+    DFA<char> dfa(0, false, 3, 2);
+    dfa.addState(2, true);
+    dfa.addState(1);
+    dfa.addTransition(0, 'b', 2);
+    dfa.addTransition(0, 'a', 1);
+    dfa.addTransition(1, 'a', 1);
+    dfa.addTransition(1, 'a', 0);
+
+    REQUIRE(dfa.getNumberOfStates() == 3);
+    REQUIRE(dfa.getStates() == std::vector<unsigned int>({0, 2, 1}));
+    REQUIRE(dfa.getAcceptingStates() == std::vector<unsigned int>({2}));
+    REQUIRE(dfa.getTransitions(0) == DFA<char>::Row({{'a', 1}, {'b', 2}}));
+    REQUIRE(dfa.getTransitions(1) == DFA<char>::Row({{'a', 0}}));
+    REQUIRE(dfa.getTransitions(2).empty());
+    REQUIRE(dfa.getTransition(0, 'b') == 2);
+    REQUIRE(dfa.getTransition(1, 'b') == DFA<char>::none);
+    REQUIRE(dfa.getTransition(7, 'a') == DFA<char>::none);
+    REQUIRE(dfa.getNumberOfReachableStates() == 3);
+    REQUIRE_THROWS_AS(dfa.addTransition(0, 'c', 3), std::out_of_range);
+
+    REQUIRE(dfa.isAccepted(std::vector<char>({'a', 'a', 'b'})));
+    REQUIRE_FALSE(dfa.isAccepted(std::vector<char>({'a', 'b'})));
+
+    // The conversion reverses the order of the symbols
+    auto converted = dfa.convert<int>({{'a', 1}, {'b', 0}});
+    REQUIRE(converted->getNumberOfStates() == 3);
+    REQUIRE(converted->getTransitions(0) == DFA<int>::Row({{0, 2}, {1, 1}}));
+    REQUIRE(converted->isAccepted(std::vector<int>({1, 1, 0})));
+}
+
+TEST_CASE("The compiled DFA accepts the same words", "[DFA][compiled]") {
+    unsigned int n = GENERATE(1, 3, 255, 256, 300, 70000);
+    DFA<char> dfa = countingDFA(n);
+    CompiledDFA<char> compiled(dfa);
+
+    REQUIRE(compiled.getNumberOfStates() == n + 1);
+    // With one state, c is never defined
+    REQUIRE(compiled.getNumberOfColumns() == (n == 1 ? 3 : 4));
+    if (n < 256) {
+        REQUIRE(compiled.getEntrySize() == 1);
+    }
+    else if (n < 65536) {
+        REQUIRE(compiled.getEntrySize() == 2);
+    }
+    else {
+        REQUIRE(compiled.getEntrySize() == 4);
+    }
+
+    // d is not in the alphabet of the DFA
+    const std::vector<std::string> words = randomWords(2000, 20, "aaabcd");
+    std::vector<bool> expected;
+    for (const auto &word : words) {
+        expected.push_back(dfa.isAccepted(std::list<char>(word.begin(), word.end())));
+        REQUIRE(compiled.isAccepted(word) == expected.back());
+    }
+
+    SECTION("One word at a time") {
+        for (std::size_t i = 0 ; i < words.size() ; i++) {
+            REQUIRE(compiled.isAccepted(std::list<char>(words[i].begin(), words[i].end())) == expected[i]);
+        }
+    }
+
+    SECTION("Several words at a time") {
+        REQUIRE(compiled.classify(words.begin(), words.end()) == expected);
+        REQUIRE(compiled.classify(words.begin(), words.begin()).empty());
+        REQUIRE(compiled.classify(words.begin(), words.begin() + 3) == std::vector<bool>(expected.begin(), expected.begin() + 3));
+    }
+
+    SECTION("Several threads") {
+        REQUIRE(compiled.classify(words.begin(), words.end(), 4) == expected);
+        REQUIRE(compiled.classify(words.begin(), words.end(), 0) == expected);
+        std::list<std::string> list(words.begin(), words.end());
+        REQUIRE(compiled.classify(list.begin(), list.end(), 3) == expected);
+    }
+}
+
+TEST_CASE("The compiled DFA is saved and loaded in binary", "[DFA][compiled][binaryFormat]") {
+    unsigned int n = GENERATE(3, 300, 70000);
+    CompiledDFA<char> compiled(countingDFA(n));
+    const std::string filepath = "compiledDFA-" + std::to_string(n) + ".bin";
+    compiled.save(filepath);
+
+    {
+        std::ifstream file(filepath, std::ios::binary);
+        std::string header(8, '\0');
+        file.read(&header[0], 8);
+        REQUIRE(header == std::string("GSJJDFA\0", 8));
+        unsigned char version[4];
+        file.read(reinterpret_cast<char*>(version), 4);
+        REQUIRE(version[0] == CompiledDFA<char>::formatVersion);
+    }
+
+    CompiledDFA<char> loaded = CompiledDFA<char>::load(filepath);
+    REQUIRE(loaded.getNumberOfStates() == compiled.getNumberOfStates());
+    REQUIRE(loaded.getNumberOfColumns() == compiled.getNumberOfColumns());
+    REQUIRE(loaded.getEntrySize() == compiled.getEntrySize());
+
+    const std::vector<std::string> words = randomWords(2000, 20, "aaabcd");
+    const std::vector<bool> expected = compiled.classify(words.begin(), words.end());
+    REQUIRE(loaded.classify(words.begin(), words.end()) == expected);
+    REQUIRE(loaded.classify(words.begin(), words.end(), 4) == expected);
+
+    // The copies share the mapping
+    CompiledDFA<char> copy = loaded;
+    for (std::size_t i = 0 ; i < words.size() ; i++) {
+        REQUIRE(copy.isAccepted(words[i]) == expected[i]);
+    }
+
+    std::remove(filepath.c_str());
+}
+
+TEST_CASE("The invalid binary files are rejected", "[DFA][compiled][binaryFormat]") {
+    const std::string filepath = "compiledDFA-invalid.bin";
+    CompiledDFA<char> compiled(countingDFA(3));
+    std::ostringstream image;
+    compiled.write(image);
+    const std::string content = image.str();
+
+    auto saveAndLoad = [&filepath](const std::string &content) {
+        std::ofstream file(filepath, std::ios::binary);
+        file.write(content.data(), content.size());
+        file.close();
+        CompiledDFA<char>::load(filepath);
+    };
+
+    REQUIRE_NOTHROW(saveAndLoad(content));
+    SECTION("Empty file") {
+        REQUIRE_THROWS_AS(saveAndLoad(""), std::runtime_error);
+    }
+    SECTION("Wrong magic number") {
+        std::string wrong = content;
+        wrong[0] = 'X';
+        REQUIRE_THROWS_AS(saveAndLoad(wrong), std::runtime_error);
+    }
+    SECTION("Unknown version") {
+        std::string wrong = content;
+        wrong[8] = 2;
+        REQUIRE_THROWS_AS(saveAndLoad(wrong), std::runtime_error);
+    }
+    SECTION("Truncated table") {
+        REQUIRE_THROWS_AS(saveAndLoad(content.substr(0, content.size() - 1)), std::runtime_error);
+    }
+    SECTION("Missing file") {
+        std::remove(filepath.c_str());
+        REQUIRE_THROWS_AS(CompiledDFA<char>::load(filepath), std::invalid_argument);
+    }
+
+    std::remove(filepath.c_str());
+}
\ No newline at end of file
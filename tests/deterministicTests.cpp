@@ -5,11 +5,19 @@
 #include <iostream>
 #include <chrono>
 #include <thread>
+#include <algorithm>
+#include <fstream>
+#include <cstdio>
+#include <list>
+#include <memory>
 
 #include "gsjj/DFA.h"
 #include "gsjj/passive/Method.h"
 #include "gsjj/passive/utils.h"
 #include "gsjj/passive/MethodFactory.h"
+#include "gsjj/passive/Sample.h"
+#include "gsjj/passive/CNF/SATCNFMethod.h"
+#include "gsjj/passive/NonCNF/SATNonCNFMethod.h"
 
 #include "utils.h"
 
@@ -20,15 +28,24 @@ using namespace gsjj;
  * @param Sp The \f$S_+\f$
  * @param Sm The \f$S_-\f$
  * @param expectedSize The expected size of the DFA
+ * @param incremental Whether the number of states must be searched in incremental mode
+ * @param search The name of the search strategy to use
+ * @param numberThreads The number of numbers of states solved at the same time
  */
-void performTests(const std::string &met, const std::set<std::string> &Sp, const std::set<std::string> &Sm, unsigned int expectedSize) {
+void performTests(const std::string &met, const std::set<std::string> &Sp, const std::set<std::string> &Sm, unsigned int expectedSize, bool incremental = false, const std::string &search = "linear", unsigned int numberThreads = 1) {
+    std::unique_ptr<passive::SearchStrategy> strategy = passive::constructSearchStrategy(search);
     std::unique_ptr<passive::Method> method;
     bool success;
-    std::tie(method, success) = passive::constructMethod(met, Sp, Sm);
+    std::tie(method, success) = passive::constructMethod(met, Sp, Sm, *strategy, std::chrono::seconds(0), nullptr, incremental, numberThreads);
 
     REQUIRE(method);
     REQUIRE(success);
 
+    REQUIRE(strategy->isFinished());
+    REQUIRE(strategy->getLowerBound() == expectedSize);
+    REQUIRE(strategy->getUpperBound() == expectedSize);
+    REQUIRE_FALSE(strategy->getProbes().empty());
+
     REQUIRE(method->solve());
     REQUIRE(method->hasSolution());
     REQUIRE(method->numberOfStates() == expectedSize);
@@ -41,41 +58,41 @@ void performTests(const std::string &met, const std::set<std::string> &Sp, const
     REQUIRE(method->numberOfStates() == dfa->getNumberOfStates());
 }
 
-void testMethod(const std::string &met) {
+void testMethod(const std::string &met, bool incremental = false, const std::string &search = "linear", unsigned int numberThreads = 1) {
     std::set<std::string> Sp, Sm;
     SECTION("Sp = {aab, aba, ba, babb} and Sm = {epsilon, bb}") {
         Sp = {"aab", "aba", "ba", "babb"};
         Sm = {"", "bb"};
 
-        performTests(met, Sp, Sm, 2);
+        performTests(met, Sp, Sm, 2, incremental, search, numberThreads);
     }
 
     SECTION("Sp = {aa, ba, aba} and Sm = {epsilon, ab}") {
         Sp = {"aa", "ba", "aba"};
         Sm = {"", "ab"};
 
-        performTests(met, Sp, Sm, 2);
+        performTests(met, Sp, Sm, 2, incremental, search, numberThreads);
     }
 
     SECTION("Sp = {epsilon, 001, 1, 10, 100, 111} and Sm = {0, 01, 00, 000}") {
         Sp = {"", "001", "1", "10", "100", "111"};
         Sm = {"0", "01", "00", "000"};
 
-        performTests(met, Sp, Sm, 4);
+        performTests(met, Sp, Sm, 4, incremental, search, numberThreads);
     }
 
     SECTION("Sp = {1, 0, 00, 10} and Sm = {epsilon, 11}") {
         Sp = {"1", "0", "00", "10"};
         Sm = {"", "11"};
 
-        performTests(met, Sp, Sm, 2);
+        performTests(met, Sp, Sm, 2, incremental, search, numberThreads);
     }
 
     SECTION("Sp = {epsilon} and Sm = {}") {
         Sp = {""};
         Sm = {};
 
-        performTests(met, Sp, Sm, 1);
+        performTests(met, Sp, Sm, 1, incremental, search, numberThreads);
     }
 }
 
@@ -83,6 +100,15 @@ TEST_CASE("The Biermann and Feldman method builds an optimal DFA", "[passive][op
     testMethod("biermann");
 }
 
+TEST_CASE("The Biermann and Feldman method builds an optimal DFA in incremental mode", "[passive][optimal][biermann][incremental]") {
+    testMethod("biermann", true);
+}
+
+TEST_CASE("The Biermann and Feldman method with bit-vectors builds an optimal DFA", "[passive][optimal][biermann][bitVector]") {
+    testMethod("biermannBV");
+    testMethod("biermannBV", true);
+}
+
 TEST_CASE("The unary method builds an optimal DFA", "[passive][optimal][unary]") {
     testMethod("unary");
 }
@@ -91,14 +117,290 @@ TEST_CASE("The binary method builds an optimal DFA", "[passive][optimal][binary]
     testMethod("binary");
 }
 
+TEST_CASE("The directly encoded binary method builds an optimal DFA", "[passive][optimal][binaryDirect]") {
+    testMethod("binaryDirect");
+}
+
 TEST_CASE("The Heule and Verwer method builds an optimal DFA", "[passive][optimal][heule]") {
     testMethod("heule");
 }
 
+TEST_CASE("The Heule and Verwer method with BFS-based symmetry breaking builds an optimal DFA", "[passive][optimal][heuleBFS]") {
+    testMethod("heuleBFS");
+}
+
+TEST_CASE("The unary method builds an optimal DFA in incremental mode", "[passive][optimal][unary][incremental]") {
+    testMethod("unary", true);
+}
+
+TEST_CASE("The directly encoded binary method builds an optimal DFA in incremental mode", "[passive][optimal][binaryDirect][incremental]") {
+    testMethod("binaryDirect", true);
+}
+
+TEST_CASE("The Heule and Verwer method builds an optimal DFA in incremental mode", "[passive][optimal][heule][incremental]") {
+    testMethod("heule", true);
+}
+
+TEST_CASE("The Heule and Verwer method with BFS-based symmetry breaking builds an optimal DFA in incremental mode", "[passive][optimal][heuleBFS][incremental]") {
+    testMethod("heuleBFS", true);
+}
+
+TEST_CASE("The prefixes in the conflict clique must reach different states", "[passive][clique]") {
+    std::set<std::string> Sp = {"", "001", "1", "10", "100", "111"};
+    std::set<std::string> Sm = {"0", "01", "00", "000"};
+    passive::PrefixTree tree(Sp, Sm);
+
+    REQUIRE(passive::areInConflict("", "0", Sp, Sm));
+    REQUIRE(passive::areInConflict("0", "", Sp, Sm));
+    REQUIRE_FALSE(passive::areInConflict("1", "10", Sp, Sm));
+
+    REQUIRE(tree.areInConflict(tree.find(""), tree.find("0")));
+    REQUIRE_FALSE(tree.areInConflict(tree.find("1"), tree.find("10")));
+
+    std::vector<std::string> clique = passive::computeConflictClique(Sp, Sm);
+    // The optimal DFA has 4 states
+    REQUIRE(clique.size() >= 2);
+    REQUIRE(clique.size() <= 4);
+    for (std::size_t i = 0 ; i < clique.size() ; i++) {
+        for (std::size_t j = i + 1 ; j < clique.size() ; j++) {
+            REQUIRE(passive::areInConflict(clique[i], clique[j], Sp, Sm));
+        }
+    }
+
+    // Both versions agree
+    std::vector<unsigned int> cliqueIds = passive::computeConflictClique(tree);
+    REQUIRE(cliqueIds.size() == clique.size());
+    for (std::size_t i = 0 ; i < clique.size() ; i++) {
+        REQUIRE(tree.getPrefix(cliqueIds[i]) == clique[i]);
+    }
+}
+
+TEST_CASE("The prefix tree contains every prefix in breadth-first order", "[passive][prefixTree]") {
+    std::set<std::string> Sp, Sm;
+    passive::generateRandomly(200, 0, 10, 3, Sp, Sm);
+    std::set<std::string> prefixes = passive::computePrefixes(passive::computeS(Sp, Sm));
+
+    passive::PrefixTree tree(Sp, Sm);
+    REQUIRE(tree.size() == prefixes.size());
+    REQUIRE(tree.getAlphabet() == passive::computeAlphabet(passive::computeS(Sp, Sm)));
+    REQUIRE(tree[0].parent == passive::PrefixTree::none);
+
+    std::string previous;
+    for (unsigned int id = 0 ; id < tree.size() ; id++) {
+        std::string prefix = tree.getPrefix(id);
+        REQUIRE(prefixes.count(prefix) == 1);
+        REQUIRE(tree.find(prefix) == id);
+        REQUIRE(tree[id].depth == prefix.size());
+
+        // Breadth-first order: by length, then lexicographically
+        if (id > 0) {
+            REQUIRE((previous.size() < prefix.size() || (previous.size() == prefix.size() && previous < prefix)));
+            REQUIRE(tree[id].parent < id);
+            REQUIRE(tree.getChild(tree[id].parent, tree[id].symbol) == id);
+        }
+
+        if (Sp.count(prefix) == 1) {
+            REQUIRE(tree[id].label == passive::PrefixTree::Label::Accept);
+        }
+        else if (Sm.count(prefix) == 1) {
+            REQUIRE(tree[id].label == passive::PrefixTree::Label::Reject);
+        }
+        else {
+            REQUIRE(tree[id].label == passive::PrefixTree::Label::Unknown);
+        }
+        previous = prefix;
+    }
+
+    REQUIRE(tree.find("d") == passive::PrefixTree::none);
+
+    // The tree and the string-based test agree on the conflicts
+    for (unsigned int u = 0 ; u < std::min<std::size_t>(tree.size(), 30) ; u++) {
+        for (unsigned int v = 0 ; v < std::min<std::size_t>(tree.size(), 30) ; v++) {
+            REQUIRE(tree.areInConflict(u, v) == passive::areInConflict(tree.getPrefix(u), tree.getPrefix(v), Sp, Sm));
+        }
+    }
+}
+
+TEST_CASE("The prefix pairs are the pairs with a common next symbol", "[passive][prefixTree][prefixPairs]") {
+    std::set<std::string> Sp, Sm;
+    passive::generateRandomly(50, 0, 6, 2, Sp, Sm);
+    passive::PrefixTree tree(Sp, Sm);
+
+    std::vector<passive::PrefixPair> pairs = passive::computePrefixPairs(tree);
+    auto pair = pairs.begin();
+    // The pairs are sorted by u and then by v
+    for (unsigned int u = 0 ; u < tree.size() ; u++) {
+        for (unsigned int v = u + 1 ; v < tree.size() ; v++) {
+            bool sharedSymbol = std::any_of(tree[u].children.begin(), tree[u].children.end(), [&](unsigned int ua) {
+                return tree.getChild(v, tree[ua].symbol) != passive::PrefixTree::none;
+            });
+            if (sharedSymbol) {
+                REQUIRE(pair != pairs.end());
+                REQUIRE(pair->u == u);
+                REQUIRE(pair->v == v);
+                REQUIRE(pair->compatible == !tree.areInConflict(u, v));
+                ++pair;
+            }
+        }
+    }
+    REQUIRE(pair == pairs.end());
+}
+
+TEST_CASE("The sample is built once and shared by the methods", "[passive][sample]") {
+    std::set<std::string> Sp, Sm;
+    passive::generateRandomly(50, 0, 6, 2, Sp, Sm);
+    auto sample = std::make_shared<const passive::Sample>(Sp, Sm);
+
+    REQUIRE(sample->getSp() == Sp);
+    REQUIRE(sample->getSm() == Sm);
+    REQUIRE(sample->getPrefixTree().size() == passive::computePrefixes(passive::computeS(Sp, Sm)).size());
+    REQUIRE(sample->getAlphabet() == passive::computeAlphabet(passive::computeS(Sp, Sm)));
+    REQUIRE(sample->getSpIds().size() == Sp.size());
+    REQUIRE(sample->getSmIds().size() == Sm.size());
+    REQUIRE(sample->getConflictClique() == passive::computeConflictClique(Sp, Sm));
+    REQUIRE(sample->getPrefixPairs().size() == passive::computePrefixPairs(sample->getPrefixTree()).size());
+    for (unsigned int a = 0 ; a < sample->getSymbols().size() ; a++) {
+        REQUIRE(sample->symbolIndex(sample->getSymbols()[a]) == a);
+    }
+
+    // The methods keep a reference to the sample, not a copy
+    std::unique_ptr<passive::Method> unary = passive::constructMethod("unary", 2, sample);
+    std::unique_ptr<passive::Method> heule = passive::constructMethod("heule", 2, sample);
+    REQUIRE(sample.use_count() == 3);
+    REQUIRE(unary->solve() == heule->solve());
+    unary = nullptr;
+    heule = nullptr;
+    REQUIRE(sample.use_count() == 1);
+
+    bool success;
+    std::unique_ptr<passive::Method> method;
+    std::tie(method, success) = passive::constructMethod("heule", sample);
+    REQUIRE(success);
+    auto dfa = method->constructDFA();
+    for (const auto &u : Sp) {
+        REQUIRE(dfa->isAccepted(std::list<char>(u.begin(), u.end())));
+    }
+    for (const auto &u : Sm) {
+        REQUIRE_FALSE(dfa->isAccepted(std::list<char>(u.begin(), u.end())));
+    }
+}
+
+TEST_CASE("The search strategies find the optimal number of states", "[passive][optimal][heule][search]") {
+    SECTION("Exponential and binary search") {
+        testMethod("heule", false, "exponential");
+    }
+
+    SECTION("Exponential and binary search in incremental mode") {
+        testMethod("heule", true, "exponential");
+    }
+
+    SECTION("Descending search") {
+        testMethod("heule", false, "descending");
+    }
+
+    SECTION("SAT-first search") {
+        testMethod("heule", false, "satFirst");
+    }
+
+    SECTION("Speculative search with 3 threads") {
+        testMethod("heule", false, "linear", 3);
+    }
+
+    SECTION("Speculative search with 3 threads and the binary method") {
+        testMethod("binary", false, "linear", 3);
+    }
+}
+
+/**
+ * Requires that the CNF methods build optimal DFA with the given at-most-one encoding
+ * @param encoding The name of the encoding
+ */
+void testAtMostOneEncoding(const std::string &encoding) {
+    passive::CNF::SATCNFMethod::setDefaultAtMostOneEncoding(passive::CNF::atMostOneEncodingFromName(encoding));
+
+    SECTION("Unary") {
+        testMethod("unary");
+    }
+    SECTION("Heule and Verwer") {
+        testMethod("heule");
+    }
+    SECTION("Heule and Verwer in incremental mode") {
+        testMethod("heule", true);
+    }
+    SECTION("Heule and Verwer with BFS-based symmetry breaking in incremental mode") {
+        testMethod("heuleBFS", true);
+    }
+
+    passive::CNF::SATCNFMethod::setDefaultAtMostOneEncoding(passive::CNF::AtMostOneEncoding::Pairwise);
+}
+
+TEST_CASE("Every at-most-one encoding builds an optimal DFA", "[passive][optimal][amo]") {
+    SECTION("Pairwise") {
+        testAtMostOneEncoding("pairwise");
+    }
+    SECTION("Sequential counter") {
+        testAtMostOneEncoding("sequential");
+    }
+    SECTION("Commander") {
+        testAtMostOneEncoding("commander");
+    }
+    SECTION("Product") {
+        testAtMostOneEncoding("product");
+    }
+}
+
+/**
+ * Requires that a portfolio of methods builds an optimal DFA of the expected size
+ */
+void performPortfolioTests(const std::set<std::string> &Sp, const std::set<std::string> &Sm, unsigned int expectedSize) {
+    const std::vector<std::string> portfolio = {"heule", "unary", "binary"};
+
+    std::unique_ptr<passive::Method> method;
+    bool success;
+    std::string winner;
+    std::tie(method, success) = passive::constructMethodPortfolio(portfolio, Sp, Sm, std::chrono::seconds(0), &winner);
+
+    REQUIRE(method);
+    REQUIRE(success);
+    REQUIRE(std::find(portfolio.begin(), portfolio.end(), winner) != portfolio.end());
+    REQUIRE(method->numberOfStates() == expectedSize);
+
+    std::shared_ptr<DFA<char>> dfa = std::move(method->constructDFA());
+    REQUIRE(dfa);
+    checkConsistency(dfa, Sp, Sm);
+}
+
+TEST_CASE("A portfolio of methods builds an optimal DFA", "[passive][optimal][portfolio]") {
+    SECTION("Sp = {aab, aba, ba, babb} and Sm = {epsilon, bb}") {
+        performPortfolioTests({"aab", "aba", "ba", "babb"}, {"", "bb"}, 2);
+    }
+
+    SECTION("Sp = {epsilon, 001, 1, 10, 100, 111} and Sm = {0, 01, 00, 000}") {
+        performPortfolioTests({"", "001", "1", "10", "100", "111"}, {"0", "01", "00", "000"}, 4);
+    }
+
+    SECTION("Sp = {epsilon} and Sm = {}") {
+        performPortfolioTests({""}, {}, 1);
+    }
+}
+
+TEST_CASE("A portfolio with an unknown method is rejected", "[passive][portfolio]") {
+    REQUIRE_THROWS_AS(passive::constructMethodPortfolio({"heule", "unknown"}, {"a"}, {""}), std::invalid_argument);
+}
+
 TEST_CASE("The Neider and Jansen method builds an optimal DFA", "[passive][optimal][neider]") {
     testMethod("neider");
 }
 
+TEST_CASE("The Neider and Jansen method builds an optimal DFA in incremental mode", "[passive][optimal][neider][incremental]") {
+    testMethod("neider", true);
+}
+
+TEST_CASE("The Neider and Jansen method with bit-vectors builds an optimal DFA", "[passive][optimal][neider][bitVector]") {
+    testMethod("neiderBV");
+    testMethod("neiderBV", true);
+}
+
 TEST_CASE("The unaryNonCNF method builds an optimal DFA", "[passive][optimal][unaryNonCNF]") {
     testMethod("unaryNonCNF");
 }
@@ -109,4 +411,51 @@ TEST_CASE("The binaryNonCNF method builds an optimal DFA", "[passive][optimal][b
 
 TEST_CASE("The Heule and Verwer nonCNF method builds an optimal DFA", "[passive][optimal][heuleNonCNF]") {
     testMethod("heuleNonCNF");
+}
+
+/**
+ * Requires that the formula written by the method is satisfiable iff the method has a solution
+ */
+void testWrittenFormula(const std::string &met) {
+    std::set<std::string> Sp = {"", "001", "1", "10", "100", "111"};
+    std::set<std::string> Sm = {"0", "01", "00", "000"};
+    const std::string in = met + "-formula.limboole";
+    const std::string out = in + ".out";
+
+    for (unsigned int n = 2 ; n <= 5 ; n++) {
+        std::unique_ptr<passive::Method> method = passive::constructMethod(met, n, Sp, Sm);
+        auto nonCNF = dynamic_cast<passive::NonCNF::SATNonCNFMethod*>(method.get());
+        REQUIRE(nonCNF);
+
+        REQUIRE(nonCNF->writeFormula(in));
+        const char* argv[] = {"./limboole", "-s", in.c_str(), "-o", out.c_str()};
+        const bool stop = false;
+        limboole(5, argv, &stop);
+
+        std::ifstream file(out);
+        std::string line;
+        std::getline(file, line);
+        bool satisfiable = line.find("UNSATISFIABLE") == std::string::npos;
+
+        // The optimal DFA has 4 states
+        REQUIRE(satisfiable == (n >= 4));
+        REQUIRE(method->solve() == satisfiable);
+    }
+
+    std::remove(in.c_str());
+    std::remove(out.c_str());
+}
+
+TEST_CASE("The NonCNF methods write the formula given to the SAT solver", "[passive][NonCNF][writeFormula]") {
+    SECTION("unaryNonCNF") {
+        testWrittenFormula("unaryNonCNF");
+    }
+
+    SECTION("binaryNonCNF") {
+        testWrittenFormula("binaryNonCNF");
+    }
+
+    SECTION("heuleNonCNF") {
+        testWrittenFormula("heuleNonCNF");
+    }
 }
\ No newline at end of file
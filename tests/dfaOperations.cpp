@@ -0,0 +1,197 @@
+#include "catch.hpp"
+
+#include <algorithm>
+#include <random>
+#include <set>
+#include <string>
+#include <vector>
+
+#include "gsjj/DFA.h"
+#include "gsjj/DFAOperations.h"
+#include "gsjj/passive/MethodFactory.h"
+#include "gsjj/passive/utils.h"
+
+#include "utils.h"
+
+using namespace gsjj;
+
+namespace {
+    // The same DFA, started from another state
+    DFA<char> withInitialState(const DFA<char> &dfa, unsigned int initial) {
+        DFA<char> copy(initial, dfa.isAcceptingState(initial));
+        for (unsigned int q : dfa.getStates()) {
+            copy.addState(q, dfa.isAcceptingState(q));
+        }
+        for (unsigned int p : dfa.getStates()) {
+            for (const auto &transition : dfa.getTransitions(p)) {
+                copy.addTransition(p, transition.first, transition.second);
+            }
+        }
+        return copy;
+    }
+
+    // Every word over {a, b, c} of length at most maxLength, by increasing length
+    std::vector<std::vector<char>> allWords(unsigned int maxLength) {
+        std::vector<std::vector<char>> words = {{}};
+        for (std::size_t i = 0 ; i < words.size() ; i++) {
+            if (words[i].size() < maxLength) {
+                for (char a : {'a', 'b', 'c'}) {
+                    words.push_back(words[i]);
+                    words.back().push_back(a);
+                }
+            }
+        }
+        return words;
+    }
+}
+
+TEST_CASE("The minimal DFA accepts the same words", "[DFA][minimisation]") {
+    std::mt19937 generator(GENERATE(1, 2, 3, 4, 5));
+    const bool complete = GENERATE(false, true);
+    const auto words = allWords(6);
+
+    for (unsigned int n = 1 ; n <= 8 ; n++) {
+        DFA<char> dfa = randomDFA(generator, n);
+        auto minimal = minimise(dfa, complete);
+
+        REQUIRE(minimal->getNumberOfStates() <= dfa.getNumberOfReachableStates() + 1);
+        REQUIRE(minimal->getNumberOfReachableStates() == minimal->getNumberOfStates());
+        REQUIRE(std::none_of(words.begin(), words.end(), [&](const std::vector<char> &word) {
+            return minimal->isAccepted(word) != dfa.isAccepted(word);
+        }));
+        REQUIRE(areEquivalent(*minimal, dfa));
+
+        // The alphabet does not change
+        std::set<char> symbols, minimalSymbols;
+        for (const auto &row : dfa.getTransitions()) {
+            for (const auto &transition : row) {
+                symbols.insert(transition.first);
+            }
+        }
+        for (unsigned int q : minimal->getStates()) {
+            for (const auto &transition : minimal->getTransitions(q)) {
+                minimalSymbols.insert(transition.first);
+            }
+            if (complete) {
+                REQUIRE(minimal->getTransitions(q).size() == symbols.size());
+            }
+        }
+        if (complete) {
+            REQUIRE(minimalSymbols == symbols);
+        }
+
+        // Two states of the minimal DFA always have different languages
+        for (unsigned int p = 0 ; p < minimal->getNumberOfStates() ; p++) {
+            for (unsigned int q = p + 1 ; q < minimal->getNumberOfStates() ; q++) {
+                REQUIRE_FALSE(areEquivalent(withInitialState(*minimal, p), withInitialState(*minimal, q)));
+            }
+        }
+
+        // The minimal DFA is canonical
+        auto again = minimise(*minimal, complete);
+        REQUIRE(again->getNumberOfStates() == minimal->getNumberOfStates());
+        REQUIRE(again->to_dot() == minimal->to_dot());
+    }
+}
+
+TEST_CASE("The minimisation merges the equivalent states", "[DFA][minimisation]") {
+    // Counts the a modulo 6 but only accepts the multiples of 3. The state 6 is unreachable
+    DFA<char> dfa(0, true);
+    for (unsigned int q = 1 ; q <= 6 ; q++) {
+        dfa.addState(q, q % 3 == 0);
+    }
+    for (unsigned int q = 0 ; q < 6 ; q++) {
+        dfa.addTransition(q, 'a', (q + 1) % 6);
+        dfa.addTransition(q, 'b', q);
+    }
+    dfa.addTransition(6, 'a', 0);
+
+    auto minimal = minimise(dfa);
+    REQUIRE(minimal->getNumberOfStates() == 3);
+    REQUIRE(minimal->getInitialState() == 0);
+    REQUIRE(minimal->getTransitions(0) == DFA<char>::Row({{'a', 1}, {'b', 0}}));
+    REQUIRE(minimal->getTransitions(1) == DFA<char>::Row({{'a', 2}, {'b', 1}}));
+    REQUIRE(minimal->getTransitions(2) == DFA<char>::Row({{'a', 0}, {'b', 2}}));
+    REQUIRE(minimal->getAcceptingStates() == std::vector<unsigned int>({0}));
+
+    SECTION("The empty language") {
+        DFA<char> empty(0, false);
+        empty.addState(1);
+        empty.addTransition(0, 'a', 1);
+        empty.addTransition(1, 'a', 0);
+        REQUIRE(minimise(empty)->getNumberOfStates() == 1);
+        REQUIRE(minimise(empty)->getTransitions(0).empty());
+        REQUIRE(minimise(empty, true)->getTransitions(0) == DFA<char>::Row({{'a', 0}}));
+    }
+
+    SECTION("The dead states") {
+        // a is accepted, every other word is rejected
+        DFA<char> single(0, false);
+        single.addState(1, true);
+        single.addState(2);
+        single.addTransition(0, 'a', 1);
+        single.addTransition(1, 'a', 2);
+        single.addTransition(2, 'a', 2);
+        REQUIRE(minimise(single)->getNumberOfStates() == 2);
+        REQUIRE(minimise(single, true)->getNumberOfStates() == 3);
+    }
+}
+
+TEST_CASE("The distinguishing word is a shortest one", "[DFA][equivalence]") {
+    std::mt19937 generator(GENERATE(1, 2, 3, 4, 5));
+    const auto words = allWords(7);
+
+    for (unsigned int i = 0 ; i < 20 ; i++) {
+        DFA<char> first = randomDFA(generator, 1 + i % 4);
+        DFA<char> second = randomDFA(generator, 1 + i % 5);
+
+        // The words are sorted by length
+        const std::vector<char> *shortest = nullptr;
+        for (const auto &word : words) {
+            if (first.isAccepted(word) != second.isAccepted(word)) {
+                shortest = &word;
+                break;
+            }
+        }
+
+        std::vector<char> word;
+        bool different = findDistinguishingWord(first, second, word);
+        // With at most 4 and 5 states, the languages are equal if no word of length 7 distinguishes them
+        REQUIRE(different == (shortest != nullptr));
+        if (different) {
+            REQUIRE(word.size() == shortest->size());
+            REQUIRE(first.isAccepted(word) != second.isAccepted(word));
+        }
+        REQUIRE_FALSE(findDistinguishingWord(first, first, word));
+    }
+}
+
+TEST_CASE("The methods learn the same language", "[passive][minimisation]") {
+    std::set<std::string> Sp, Sm;
+    passive::generateRandomly(50, 0, 6, 2, Sp, Sm);
+    auto sample = std::make_shared<const passive::Sample>(Sp, Sm);
+
+    bool success;
+    std::unique_ptr<passive::Method> heule, unary;
+    std::tie(heule, success) = passive::constructMethod("heule", sample);
+    REQUIRE(success);
+    std::tie(unary, success) = passive::constructMethod("unary", sample);
+    REQUIRE(success);
+
+    auto heuleDFA = heule->constructDFA();
+    auto unaryDFA = unary->constructDFA();
+    auto minimalHeule = minimise(*heuleDFA, true);
+    auto minimalUnary = minimise(*unaryDFA, true);
+
+    // The DFAs are already minimal (since they are the smallest consistent DFAs)
+    REQUIRE(minimalHeule->getNumberOfStates() == heuleDFA->getNumberOfStates());
+    REQUIRE(minimalUnary->getNumberOfStates() == unaryDFA->getNumberOfStates());
+    REQUIRE(areEquivalent(*minimalHeule, *heuleDFA));
+    REQUIRE(areEquivalent(*minimalUnary, *unaryDFA));
+    for (const auto &word : Sp) {
+        REQUIRE(minimalHeule->isAccepted(std::vector<char>(word.begin(), word.end())));
+    }
+    for (const auto &word : Sm) {
+        REQUIRE_FALSE(minimalUnary->isAccepted(std::vector<char>(word.begin(), word.end())));
+    }
+}
\ No newline at end of file
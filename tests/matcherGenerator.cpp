@@ -0,0 +1,69 @@
+#include "catch.hpp"
+
+#include <stdexcept>
+#include <string>
+
+#include "gsjj/DFA.h"
+#include "gsjj/MatcherGenerator.h"
+
+using namespace gsjj;
+
+namespace {
+    // Accepts the words over {a, b} that end with a. The state 3 is not reachable
+    DFA<char> endsWithA() {
+        DFA<char> dfa(0, false);
+        dfa.addState(1, true);
+        dfa.addState(3, true);
+        dfa.addTransition(0, 'a', 1);
+        dfa.addTransition(0, 'b', 0);
+        dfa.addTransition(1, 'a', 1);
+        dfa.addTransition(1, 'b', 0);
+        dfa.addTransition(3, 'c', 0);
+        return dfa;
+    }
+
+    std::size_t count(const std::string &code, const std::string &pattern) {
+        std::size_t number = 0;
+        for (std::size_t i = code.find(pattern) ; i != std::string::npos ; i = code.find(pattern, i + 1)) {
+            number++;
+        }
+        return number;
+    }
+}
+
+TEST_CASE("The switch matcher has one label per reachable state", "[matcher]") {
+    std::string code = generateMatcher(endsWithA(), "endsWithA");
+
+    REQUIRE(code.find("namespace endsWithA {") != std::string::npos);
+    REQUIRE(count(code, "inline bool isAccepted(const char *word, std::size_t length)") == 1);
+    REQUIRE(count(code, "bool isAccepted(const Word &word)") == 1);
+    REQUIRE(count(code, "    state1:") == 1);
+    REQUIRE(count(code, "    state2:") == 1);
+    REQUIRE(count(code, "    state3:") == 0);
+    REQUIRE(count(code, "case 97: // a") == 2);
+    REQUIRE(count(code, "case 98: // b") == 2);
+    REQUIRE(count(code, "case 99") == 0);
+    REQUIRE(count(code, "return true;") == 1);
+}
+
+TEST_CASE("The table matcher checks its alphabet", "[matcher]") {
+    std::string code = generateMatcher(endsWithA(), "endsWithA", MatcherStyle::Table);
+
+    REQUIRE(code.find("static constexpr unsigned char alphabet[2] = {97, 98};") != std::string::npos);
+    REQUIRE(code.find("static_assert(detail::checkColumns(columns, alphabet, 2)") != std::string::npos);
+    // The sink, the initial state and the accepting state, with the columns of the other bytes, a and b
+    REQUIRE(code.find("static constexpr std::uint8_t delta[3 * 3] = {\n            0, 0, 0,\n            0, 2, 1,\n            0, 2, 1,\n        };") != std::string::npos);
+    REQUIRE(code.find("static constexpr bool accepting[3] = {\n            false, false, true,\n        };") != std::string::npos);
+}
+
+TEST_CASE("The matcher styles and names are checked", "[matcher]") {
+    REQUIRE(matcherStyleFromName("switch") == MatcherStyle::Switch);
+    REQUIRE(matcherStyleFromName("table") == MatcherStyle::Table);
+    REQUIRE_THROWS_AS(matcherStyleFromName("goto"), std::invalid_argument);
+
+    DFA<char> dfa = endsWithA();
+    REQUIRE_NOTHROW(generateMatcher(dfa, "_matcher2"));
+    REQUIRE_THROWS_AS(generateMatcher(dfa, ""), std::invalid_argument);
+    REQUIRE_THROWS_AS(generateMatcher(dfa, "2matcher"), std::invalid_argument);
+    REQUIRE_THROWS_AS(generateMatcher(dfa, "my-matcher"), std::invalid_argument);
+}
\ No newline at end of file
@@ -16,4 +16,21 @@ void checkConsistency(std::shared_ptr<DFA<char>> dfa, const std::set<std::string
             REQUIRE_FALSE(dfa->isAccepted(std::list<char>(word.begin(), word.end())));
         }
     }
+}
+
+DFA<char> randomDFA(std::mt19937 &generator, unsigned int numberStates) {
+    std::uniform_int_distribution<unsigned int> state(0, numberStates - 1);
+    std::bernoulli_distribution coin(0.5), missing(0.15);
+    DFA<char> dfa(0, coin(generator), numberStates, 3);
+    for (unsigned int q = 1 ; q < numberStates ; q++) {
+        dfa.addState(q, coin(generator));
+    }
+    for (unsigned int p = 0 ; p < numberStates ; p++) {
+        for (char a : {'a', 'b', 'c'}) {
+            if (!missing(generator)) {
+                dfa.addTransition(p, a, state(generator));
+            }
+        }
+    }
+    return dfa;
 }
\ No newline at end of file
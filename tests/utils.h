@@ -1,9 +1,13 @@
 #pragma once
 
 #include <memory>
+#include <random>
 
 #include "gsjj/passive/Method.h"
 
 using namespace gsjj;
 
-void checkConsistency(std::shared_ptr<DFA<char>> dfa, const std::set<std::string> &Sp, const std::set<std::string> &Sm);
\ No newline at end of file
+void checkConsistency(std::shared_ptr<DFA<char>> dfa, const std::set<std::string> &Sp, const std::set<std::string> &Sm);
+
+// A random DFA over {a, b, c}. Some transitions are missing and some states may be unreachable
+DFA<char> randomDFA(std::mt19937 &generator, unsigned int numberStates);
\ No newline at end of file
@@ -0,0 +1,83 @@
+#include "catch.hpp"
+
+#include <algorithm>
+#include <random>
+#include <set>
+#include <string>
+#include <vector>
+
+#include "gsjj/DFA.h"
+#include "gsjj/passive/Sample.h"
+#include "gsjj/passive/Verification.h"
+#include "gsjj/passive/utils.h"
+
+#include "utils.h"
+
+using namespace gsjj;
+
+namespace {
+    // The misclassified words, one word at a time, sorted by length and then lexicographically
+    std::vector<std::string> misclassifiedWords(const DFA<char> &dfa, const std::set<std::string> &words, bool accepted) {
+        std::vector<std::string> misclassified;
+        for (const auto &word : words) {
+            if (dfa.isAccepted(std::vector<char>(word.begin(), word.end())) != accepted) {
+                misclassified.push_back(word);
+            }
+        }
+        std::stable_sort(misclassified.begin(), misclassified.end(), [](const std::string &u, const std::string &v) {
+            return u.size() < v.size();
+        });
+        return misclassified;
+    }
+}
+
+TEST_CASE("The verification finds the misclassified words", "[verification]") {
+    unsigned int threads = GENERATE(1, 2, 0);
+
+    std::mt19937 generator(7);
+    for (unsigned int i = 0 ; i < 20 ; i++) {
+        std::set<std::string> Sp, Sm;
+        passive::generateRandomly(300, 0, 12, 3, Sp, Sm);
+        passive::Sample sample(Sp, Sm);
+        DFA<char> dfa = randomDFA(generator, 1 + i % 6);
+
+        passive::Misclassified misclassified = passive::verify(dfa, sample, threads);
+        REQUIRE(misclassified.rejected == misclassifiedWords(dfa, Sp, true));
+        REQUIRE(misclassified.accepted == misclassifiedWords(dfa, Sm, false));
+        REQUIRE(misclassified.empty() == (misclassified.rejected.size() + misclassified.accepted.size() == 0));
+    }
+}
+
+TEST_CASE("The levels of a big sample are split between the threads", "[verification]") {
+    std::mt19937 generator(11);
+    std::set<std::string> Sp, Sm;
+    passive::generateRandomly(50000, 8, 14, 3, Sp, Sm);
+    passive::Sample sample(Sp, Sm);
+    DFA<char> dfa = randomDFA(generator, 20);
+
+    const std::vector<std::string> rejected = misclassifiedWords(dfa, Sp, true);
+    const std::vector<std::string> accepted = misclassifiedWords(dfa, Sm, false);
+    REQUIRE_FALSE(rejected.empty());
+    REQUIRE_FALSE(accepted.empty());
+    for (unsigned int threads : {1u, 3u, 4u, 0u}) {
+        passive::Misclassified misclassified = passive::verify(dfa, sample, threads);
+        REQUIRE(misclassified.rejected == rejected);
+        REQUIRE(misclassified.accepted == accepted);
+    }
+}
+
+TEST_CASE("A missing transition rejects every word below it", "[verification]") {
+    // Accepts a and nothing else
+    DFA<char> dfa(0, false);
+    dfa.addState(1, true);
+    dfa.addTransition(0, 'a', 1);
+
+    passive::Sample sample({"a", "ab", "ba", "bab"}, {"", "b", "aa"});
+    passive::Misclassified misclassified = passive::verify(dfa, sample, 4);
+    REQUIRE(misclassified.rejected == std::vector<std::string>({"ab", "ba", "bab"}));
+    REQUIRE(misclassified.accepted.empty());
+    REQUIRE_FALSE(misclassified.empty());
+
+    passive::Sample consistent({"a"}, {"", "b", "aa", "ab"});
+    REQUIRE(passive::verify(dfa, consistent).empty());
+}
\ No newline at end of file